@@ -0,0 +1,320 @@
+/**
+ *  @file   addressable_heap.h
+ *  @brief  A priority queue built on binomial_heap whose elements are addressed by an external ID,
+ *          for Dijkstra/Prim-style loops that would otherwise keep a side map of iterators.
+ * 
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef ADDRESSABLE_HEAP
+#define ADDRESSABLE_HEAP 1
+#include <unordered_map>
+#include "binomial_heap.h"
+
+/**
+ *  @brief  A priority queue holding at most one priority per ID
+ *  @tparam Id the type of the IDs. Integral IDs are indexed by a dense vector, so they should be
+ *          small and non-negative; any other type is indexed by std::unordered_map
+ *  @tparam Priority the type of the priorities
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename Id, typename Priority, typename Comp = std::less<Priority>>
+class addressable_heap {
+public:
+    explicit addressable_heap(const Comp& compare = Comp());
+    addressable_heap(const addressable_heap& rhs);
+    addressable_heap(addressable_heap&& rhs) = default;
+    addressable_heap& operator=(const addressable_heap& rhs);
+    addressable_heap& operator=(addressable_heap&& rhs) = default;
+    size_t size() const;
+    bool empty() const;
+    bool contains(const Id& id) const;
+    const Priority& priority(const Id& id) const;
+    const Id& top_id() const;
+    const Priority& top_priority() const;
+    std::pair<Id, Priority> pop();
+    bool push_or_decrease(const Id& id, Priority priority);
+    bool erase(const Id& id);
+private:
+    struct entry {
+        Priority priority;
+        Id id;
+    };
+    struct entry_compare {
+        bool operator()(const entry& lhs, const entry& rhs) const;
+        Comp compare;
+    };
+    using heap_type = binomial_heap<entry, entry_compare>;
+    using heap_iterator = typename heap_type::iterator;
+    class dense_index {
+    public:
+        heap_iterator find(const Id& id) const;
+        heap_iterator& operator[](const Id& id);
+        void erase(const Id& id);
+    private:
+        static bool negative(const Id& id);
+        std::vector<heap_iterator> slots;
+    };
+    class hashed_index {
+    public:
+        heap_iterator find(const Id& id) const;
+        heap_iterator& operator[](const Id& id);
+        void erase(const Id& id);
+    private:
+        std::unordered_map<Id, heap_iterator> slots;
+    };
+    using index_type = typename std::conditional<
+        std::is_integral<Id>::value,
+        dense_index,
+        hashed_index
+    >::type;
+    heap_iterator locate(const Id& id) const;
+    Comp compare;
+    heap_type heap;
+    index_type index;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               addressable_heap index implementations                             *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Compares two entries by priority only
+ *  @param[in]  lhs the left-hand entry
+ *  @param[in]  rhs the right-hand entry
+ *  @return     the result of the priority comparison
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::entry_compare::operator()(
+    const entry& lhs,
+    const entry& rhs
+) const { return compare(lhs.priority, rhs.priority); }
+
+/**
+ *  @brief      Looks up an ID in the dense index. O(1) time.
+ *  @param[in]  id the ID to be found
+ *  @return     the iterator stored for id, or a default iterator if there is none
+ */
+template<typename Id, typename Priority, typename Comp>
+typename addressable_heap<Id, Priority, Comp>::heap_iterator
+addressable_heap<Id, Priority, Comp>::dense_index::find(const Id& id) const {
+    if(negative(id) || size_t(id) >= slots.size()) return heap_iterator();
+    return slots[size_t(id)];
+}
+
+/**
+ *  @brief      Gets the slot for an ID in the dense index, growing the index to cover it
+ *  @param[in]  id the ID whose slot is to be returned, must not be negative
+ *  @return     the iterator slot for id, by reference
+ */
+template<typename Id, typename Priority, typename Comp>
+typename addressable_heap<Id, Priority, Comp>::heap_iterator&
+addressable_heap<Id, Priority, Comp>::dense_index::operator[](const Id& id) {
+    if(negative(id)) throw std::out_of_range("Negative ID");
+    if(size_t(id) >= slots.size()) slots.resize(size_t(id) + 1);
+    return slots[size_t(id)];
+}
+
+/**
+ *  @brief      Clears the slot for an ID in the dense index
+ *  @param[in]  id the ID whose slot is to be cleared
+ */
+template<typename Id, typename Priority, typename Comp>
+void addressable_heap<Id, Priority, Comp>::dense_index::erase(const Id& id) {
+    slots[size_t(id)] = heap_iterator();
+}
+
+/**
+ *  @brief      Checks whether an ID is negative, without comparing unsigned IDs against zero
+ *  @param[in]  id the ID to be checked
+ *  @return     true if id is negative. Otherwise, false
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::dense_index::negative(const Id& id) {
+    if constexpr(std::is_signed<Id>::value) return id < 0;
+    else return false;
+}
+
+/**
+ *  @brief      Looks up an ID in the hashed index. O(1) expected time.
+ *  @param[in]  id the ID to be found
+ *  @return     the iterator stored for id, or a default iterator if there is none
+ */
+template<typename Id, typename Priority, typename Comp>
+typename addressable_heap<Id, Priority, Comp>::heap_iterator
+addressable_heap<Id, Priority, Comp>::hashed_index::find(const Id& id) const {
+    auto found = slots.find(id);
+    return found == slots.end() ? heap_iterator() : found->second;
+}
+
+/**
+ *  @brief      Gets the slot for an ID in the hashed index, creating it if needed
+ *  @param[in]  id the ID whose slot is to be returned
+ *  @return     the iterator slot for id, by reference
+ */
+template<typename Id, typename Priority, typename Comp>
+typename addressable_heap<Id, Priority, Comp>::heap_iterator&
+addressable_heap<Id, Priority, Comp>::hashed_index::operator[](const Id& id) { return slots[id]; }
+
+/**
+ *  @brief      Removes the slot for an ID from the hashed index
+ *  @param[in]  id the ID whose slot is to be removed
+ */
+template<typename Id, typename Priority, typename Comp>
+void addressable_heap<Id, Priority, Comp>::hashed_index::erase(const Id& id) { slots.erase(id); }
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                 addressable_heap implementation                                  *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Default constructor for the addressable_heap class
+ *  @param[in]  compare the comparison functor for priorities, defaults to std::less<Priority>
+ */
+template<typename Id, typename Priority, typename Comp>
+addressable_heap<Id, Priority, Comp>::addressable_heap(const Comp& compare) :
+    compare(compare),
+    heap(entry_compare{compare}) {}
+
+/**
+ *  @brief      Copy constructor for the addressable_heap class. The entries of rhs are inserted
+ *              into a heap of this object's own and indexed afresh, so that the index refers to
+ *              this object's nodes rather than to those of rhs. O(n) time.
+ *  @param[in]  rhs the queue to be copied
+ */
+template<typename Id, typename Priority, typename Comp>
+addressable_heap<Id, Priority, Comp>::addressable_heap(
+    const addressable_heap<Id, Priority, Comp>& rhs
+) :
+    compare(rhs.compare),
+    heap(entry_compare{rhs.compare}) {
+    rhs.heap.for_each([this](const entry& copied) { index[copied.id] = heap.iter_insert(copied); });
+}
+
+/**
+ *  @brief      Copy assignment operator for the addressable_heap class
+ *  @param[in]  rhs the queue to be copied
+ *  @return     this queue by reference for operator chaining
+ */
+template<typename Id, typename Priority, typename Comp>
+addressable_heap<Id, Priority, Comp>& addressable_heap<Id, Priority, Comp>::operator=(
+    const addressable_heap<Id, Priority, Comp>& rhs
+) {
+    if(this != &rhs) *this = addressable_heap(rhs);
+    return *this;
+}
+
+/**
+ *  @brief  Gets the number of IDs in the queue
+ *  @return the number of IDs in the queue
+ */
+template<typename Id, typename Priority, typename Comp>
+size_t addressable_heap<Id, Priority, Comp>::size() const { return heap.size(); }
+
+/**
+ *  @brief  Returns whether or not the queue is empty
+ *  @return true if the queue holds no IDs. Otherwise, false
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::empty() const { return heap.empty(); }
+
+/**
+ *  @brief      Checks whether an ID is in the queue. O(1) time.
+ *  @param[in]  id the ID to be checked
+ *  @return     true if id is in the queue. Otherwise, false
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::contains(const Id& id) const {
+    return locate(id) != heap_iterator();
+}
+
+/**
+ *  @brief      Gets the current priority of an ID. O(1) time.
+ *  @param[in]  id the ID whose priority is to be returned
+ *  @return     the priority of id, by reference
+ */
+template<typename Id, typename Priority, typename Comp>
+const Priority& addressable_heap<Id, Priority, Comp>::priority(const Id& id) const {
+    heap_iterator found = locate(id);
+    if(found == heap_iterator()) throw std::out_of_range("ID not found");
+    return (*found).priority;
+}
+
+/**
+ *  @brief  Gets the ID with the minimum priority
+ *  @return the ID with the minimum priority, by reference
+ */
+template<typename Id, typename Priority, typename Comp>
+const Id& addressable_heap<Id, Priority, Comp>::top_id() const { return heap.top().id; }
+
+/**
+ *  @brief  Gets the minimum priority in the queue
+ *  @return the minimum priority, by reference
+ */
+template<typename Id, typename Priority, typename Comp>
+const Priority& addressable_heap<Id, Priority, Comp>::top_priority() const {
+    return heap.top().priority;
+}
+
+/**
+ *  @brief  Removes the ID with the minimum priority from the queue. O(log n) time.
+ *  @return the removed ID and its priority
+ */
+template<typename Id, typename Priority, typename Comp>
+std::pair<Id, Priority> addressable_heap<Id, Priority, Comp>::pop() {
+    entry popped = heap.pop();
+    index.erase(popped.id);
+    return std::pair<Id, Priority>(std::move(popped.id), std::move(popped.priority));
+}
+
+/**
+ *  @brief      Inserts an ID that is not in the queue yet, or lowers the priority of one that is.
+ *              O(1) am. time for an insertion, O(log n) time for a decrease.
+ *  @param[in]  id the ID to be inserted or updated
+ *  @param[in]  priority the new priority of id
+ *  @return     true if id was inserted or its priority was lowered. false if id is already in the
+ *              queue with a priority no worse than the one passed in
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::push_or_decrease(const Id& id, Priority priority) {
+    heap_iterator found = locate(id);
+    if(found == heap_iterator()) {
+        heap_iterator& slot = index[id];
+        slot = heap.iter_emplace(entry{std::move(priority), id});
+        return true;
+    }
+    if(!compare(priority, (*found).priority)) return false;
+    heap.decrease_key(found, entry{std::move(priority), id});
+    return true;
+}
+
+/**
+ *  @brief      Removes an ID from the queue. O(log n) time.
+ *  @param[in]  id the ID to be removed
+ *  @return     true if id was in the queue. Otherwise, false
+ */
+template<typename Id, typename Priority, typename Comp>
+bool addressable_heap<Id, Priority, Comp>::erase(const Id& id) {
+    heap_iterator found = locate(id);
+    if(found == heap_iterator()) return false;
+    heap.remove(found);
+    index.erase(id);
+    return true;
+}
+
+/**
+ *  @brief      Looks up the heap element of an ID
+ *  @param[in]  id the ID to be found
+ *  @return     an iterator to the element holding id, or a default iterator if there is none
+ */
+template<typename Id, typename Priority, typename Comp>
+typename addressable_heap<Id, Priority, Comp>::heap_iterator
+addressable_heap<Id, Priority, Comp>::locate(const Id& id) const { return index.find(id); }
+#endif
@@ -8,46 +8,119 @@
 */
 #ifndef BINOMIAL_HEAP
 #define BINOMIAL_HEAP 1
-#include <list>
 #include <vector>
 #include <functional>
 #include <stdexcept>
 #include <iterator>
 #include <algorithm>
-/***************************************************************************************************
-* Next steps:                                                                                      *
-*   1) Add parent pointers to support decrease_key and deletion                                    *
-*       a) Updates might make other things slower? It's two pointer changes instead of one         *
-***************************************************************************************************/
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <future>
+#include <thread>
+#include <istream>
+#include <ostream>
+#include <cstring>
+#include "root_scan.h"
+
+/**
+ *  @brief  The header of a heap snapshot written by binomial_heap::save(). It is followed by
+ *          tree_count degree bytes, zero padding up to keys_offset(), and then size keys.
+ */
+struct binomial_snapshot_header {
+    static constexpr char expected_magic[4] = {'B', 'N', 'H', 'P'};
+    static constexpr uint32_t current_version = 1;
+    bool valid(size_t expected_key_size) const;
+    size_t keys_offset(size_t key_align) const;
+    char magic[4];
+    uint32_t version;
+    uint32_t key_size;
+    uint32_t tree_count;
+    uint64_t size;
+};
+
+/**
+ *  @brief      Checks the magic, version and key size of a snapshot header
+ *  @param[in]  expected_key_size the size of the keys the snapshot is to be read as
+ *  @return     true if the header can be read as a snapshot of such keys. Otherwise, false
+ */
+inline bool binomial_snapshot_header::valid(size_t expected_key_size) const {
+    return !std::memcmp(magic, expected_magic, sizeof(magic)) && version == current_version &&
+           key_size == expected_key_size;
+}
 
+/**
+ *  @brief      Gets the offset of the first key from the start of the snapshot. Keys are padded
+ *              to their alignment, so a snapshot mapped at a page boundary can be read in place.
+ *  @param[in]  key_align the alignment of the keys
+ *  @return     the offset of the first key in bytes
+ */
+inline size_t binomial_snapshot_header::keys_offset(size_t key_align) const {
+    size_t degrees_end = sizeof(binomial_snapshot_header) + tree_count;
+    return (degrees_end + key_align - 1) / key_align * key_align;
+}
 /**
  *  @brief  A binomial heap that supports fast insertion and merging
  *  @tparam T the type of the key that wil be stored in the heap
  *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ *  @tparam Allocator the allocator that node slabs and handle tables are requested from, rebound
+ *          with std::allocator_traits. defaults to std::allocator
  */
-template<typename T, typename Comp = std::less<T>>
+template<typename T, typename Comp = std::less<T>, typename Allocator = std::allocator<T>>
 class binomial_heap {
     struct node;
+    using alloc_traits = std::allocator_traits<Allocator>;
 public:
     class iterator;
-    explicit binomial_heap(const Comp& compare = Comp());
+    class handle;
+    using allocator_type = Allocator;
+    enum class merge_mode { eager, lazy };
+    explicit binomial_heap(
+        const Comp& compare = Comp(),
+        merge_mode mode = merge_mode::eager,
+        const Allocator& alloc = Allocator()
+    );
+    explicit binomial_heap(const Allocator& alloc);
     template<class InputIterator> binomial_heap(
         InputIterator start,
         InputIterator stop,
-        const Comp& compare = Comp()
+        const Comp& compare = Comp(),
+        const Allocator& alloc = Allocator()
     );
     binomial_heap(const binomial_heap& rhs);
-    binomial_heap(binomial_heap&& rhs);
+    binomial_heap(const binomial_heap& rhs, const Allocator& alloc);
+    binomial_heap(binomial_heap&& rhs) noexcept;
+    binomial_heap(binomial_heap&& rhs, const Allocator& alloc);
     binomial_heap& operator=(const binomial_heap& rhs);
-    binomial_heap& operator=(binomial_heap&& rhs);
+    binomial_heap& operator=(binomial_heap&& rhs) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value
+    );
     ~binomial_heap();
+    allocator_type get_allocator() const;
+    binomial_heap clone(size_t threads = 0) const;
     size_t size() const;
     bool empty() const;
-    iterator find(T key) const;
+    void clear();
+    merge_mode mode() const;
+    iterator find(const T& key) const;
+    template<class Visitor> void for_each(Visitor visit) const;
     T min() const;
+    const T& top() const;
     T extract();
+    T pop();
+    std::optional<T> try_extract();
     void merge(binomial_heap& rhs);
     void merge(binomial_heap&& rhs);
+    template<class ForwardIterator> void merge_all(
+        ForwardIterator first,
+        ForwardIterator last,
+        size_t threads = 0
+    );
     void insert(const T& key);
     void insert(T&& key);
     iterator iter_insert(const T& key);
@@ -63,38 +136,172 @@ public:
         InputIterator stop
     );
     void decrease_key(const iterator& it, T new_key);
-    void remove(iterator&& it);
+    void remove(const iterator& it);
+    handle handle_insert(const T& key);
+    handle handle_insert(T&& key);
+    template<class...Args> handle handle_emplace(Args&&...args);
+    handle get_handle(const iterator& it);
+    bool contains(const handle& h) const;
+    iterator lookup(const handle& h) const;
+    void decrease_key(const handle& h, T new_key);
+    void remove(const handle& h);
+    void share_handles(binomial_heap& other);
+    void save(std::ostream& out) const;
+    void load(std::istream& in);
     class iterator {
     public:
+        iterator();
         explicit iterator(node* data);
-        T operator*();
+        const T& operator*() const;
+        bool operator==(const iterator& rhs) const;
+        bool operator!=(const iterator& rhs) const;
     private:
+        friend class binomial_heap;
         node* data;
     };
+    class handle {
+    public:
+        handle();
+        bool operator==(const handle& rhs) const;
+        bool operator!=(const handle& rhs) const;
+    private:
+        friend class binomial_heap;
+        handle(uint32_t index, uint32_t generation);
+        uint32_t index;
+        uint32_t generation;
+    };
 private:
+    class node_pool;
+    struct handle_table;
+    static constexpr size_t max_degree = 64;
+    static constexpr uint32_t no_handle = UINT32_MAX;
+    static unsigned lowest_degree(uint64_t mask);
+    template<class...Args> node* create_node(Args&&...args);
+    void destroy_node(node* target);
+    void destroy_tree(node* root);
+    node* clone_tree(const node* root);
+    static node* flat_clone_tree(const node* root, node* block);
+    node* transplant_tree(node* root);
+    void copy_from(const binomial_heap& rhs, size_t threads = 1);
+    void move_from(binomial_heap& rhs);
     void delete_trees();
     void set_min();
-    void zip();
-    void fast_zip();
-    void merge_lists(std::list<node*>&& rhs);
+    void add_tree(node* tree);
+    void add_tree(node** forest, uint64_t& mask, node* tree);
+    void add_root(node* root);
+    void add_pending(node* root);
+    void splice_roots(binomial_heap& rhs);
+    iterator insert_node(node* new_tree);
+    template<class InputIterator> void bulk_insert(
+        InputIterator start,
+        InputIterator stop,
+        std::input_iterator_tag,
+        std::vector<iterator>* iters
+    );
+    template<class ForwardIterator> void bulk_insert(
+        ForwardIterator start,
+        ForwardIterator stop,
+        std::forward_iterator_tag,
+        std::vector<iterator>* iters
+    );
+    template<class ForwardIterator> void build_forest(
+        ForwardIterator start,
+        size_t count,
+        std::vector<iterator>* iters
+    );
+    void consolidate();
+    void remove_root(node* root);
+    void swap_with_parent(node* target, node* parent);
+    void release_handle(node* target);
+    template<class Visitor> static void visit_tree(const node* root, Visitor& visit);
+    void save_tree(const node* root, std::ostream& out) const;
+    node* link_tree(node* block, size_t& index, unsigned degree);
     struct node {
         node();
         explicit node(const T& key);
         explicit node(T&& key);
-        node(const node& rhs);
-        node(node&& rhs);
-        node& operator=(const node& rhs);
-        node& operator=(node&& rhs);
-        ~node();
+        template<class...Args> explicit node(std::in_place_t, Args&&...args);
         node* search(const T& target, const Comp& compare);
-        void delete_children();
         node* promote(node* to_merge, const Comp& compare);
+        node* parent();
+        unsigned char degree;
+        uint32_t handle_slot;
         T key;
-        std::list<node*> children;
-        node* parent;
+        node* child;
+        node* sibling;
+        node* back;
+    };
+    struct handle_table {
+        struct entry {
+            node* target;
+            uint32_t generation;
+            uint32_t next_free;
+        };
+        using entry_allocator = typename alloc_traits::template rebind_alloc<entry>;
+        explicit handle_table(const Allocator& alloc);
+        uint32_t acquire(node* target);
+        void release(uint32_t index);
+        std::vector<entry, entry_allocator> entries;
+        uint32_t free_head;
+    };
+    class node_pool {
+    public:
+        explicit node_pool(const Allocator& alloc);
+        node_pool(const node_pool&) = delete;
+        node_pool(node_pool&& rhs);
+        node_pool& operator=(const node_pool&) = delete;
+        node_pool& operator=(node_pool&& rhs);
+        ~node_pool();
+        void* allocate();
+        node* allocate_block(size_t count);
+        size_t spare() const;
+        void deallocate(node* target);
+        void splice(node_pool& rhs);
+        void release();
+        template<class Visitor> void drain(Visitor visit);
+        const Allocator& allocator() const;
+        void adopt_allocator(const Allocator& alloc);
+    private:
+        static constexpr size_t min_slab = 32;
+        static constexpr size_t max_slab = size_t(1) << 16;
+        static constexpr unsigned char vacant_tag = 0xFF;
+        union slot;
+        struct slab_header {
+            slot* next;
+            size_t capacity;
+            size_t used;
+        };
+        union slot {
+            slot() {}
+            ~slot() {}
+            slot* next_free;
+            slab_header header;
+            node value;
+        };
+        using slot_traits = typename alloc_traits::template rebind_traits<slot>;
+        using slot_allocator = typename slot_traits::allocator_type;
+        void add_slab();
+        Allocator alloc;
+        slot* slabs;
+        slot* last_slab;
+        slot* free_head;
+        slot* free_tail;
+        slot* bump_slab;
+        slot* bump;
+        slot* bump_end;
+        size_t free_count;
+        size_t next_capacity;
     };
     Comp compare;
-    std::list<node*> trees;
+    node_pool pool;
+    node* trees[max_degree];
+    uint64_t occupied;
+    node* pending;
+    node* pending_tail;
+    bool lazy;
+    std::shared_ptr<handle_table> handles;
+    size_t live_handles;
+    root_key_mirror<T, Comp> root_keys;
     node* _min;
     size_t _size;
 };
@@ -110,117 +317,178 @@ private:
 
 /**
  *  @brief  Dereference operator for the iterator class
- *  @return the key of the node the iterator is holding
+ *  @return the key of the node the iterator is holding, by reference
  */
-template<typename T, typename Comp>
-T binomial_heap<T, Comp>::iterator::operator*() { return data->key; }
+template<typename T, typename Comp, typename Allocator>
+const T& binomial_heap<T, Comp, Allocator>::iterator::operator*() const { return data->key; }
+
+/**
+ *  @brief  Default constructor for the iterator class. The result refers to no element.
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::iterator::iterator() : data(nullptr) {}
 
 /**
  *  @brief  Constructor for the iterator class
 */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::iterator::iterator(binomial_heap<T, Comp>::node* data) : data(data) {}
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::iterator::iterator(
+    binomial_heap<T, Comp, Allocator>::node* data
+) : data(data) {}
+
+/**
+ *  @brief      Equality operator for the iterator class
+ *  @param[in]  rhs the iterator to be compared with
+ *  @return     true if both iterators contain the same node. Otherwise, false
+ */
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::iterator::operator==(
+    const typename binomial_heap<T, Comp, Allocator>::iterator& rhs
+) const { return data == rhs.data; }
+
+/**
+ *  @brief      Inequality operator for the iterator class
+ *  @param[in]  rhs the iterator to be compared with
+ *  @return     false if both iterators contain the same node. Otherwise, true
+ */
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::iterator::operator!=(
+    const typename binomial_heap<T, Comp, Allocator>::iterator& rhs
+) const { return data != rhs.data; }
 /***************************************************************************************************
 *                                                                                                  *
 *                                                                                                  *
-*                                binomial_heap::node implementation                                *
+*                               binomial_heap::handle implementation                               *
 *                                                                                                  *
 *                                                                                                  *
 ***************************************************************************************************/
 /**
- *  @brief      Default constructor for nodes
+ *  @brief  Default constructor for handles. The result never refers to an element.
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::node() : key(T()), parent(nullptr) {}
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::handle::handle() : index(no_handle), generation(0) {}
 
 /**
- *  @brief      Constructs a node with provided key   
- *  @param[in]  key the key of the node to be constructed
+ *  @brief      Constructs a handle to a slot of a handle table
+ *  @param[in]  index the slot in the handle table
+ *  @param[in]  generation the generation of the slot when the handle was issued
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::node(const T& key) : key(key), parent(nullptr) {}
-
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::handle::handle(uint32_t index, uint32_t generation) :
+    index(index),
+    generation(generation) {}
 
 /**
- *  @brief      Constructs a node with the provided key, by move
- *  @param[in]  key the key of the node to be constructed
-*/
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::node(T&& key) : 
-    key(std::forward<T>(key)),
-    parent(nullptr) {}
+ *  @brief      Equality operator for handles
+ *  @param[in]  rhs the handle to be compared with
+ *  @return     true if both handles were issued for the same element. Otherwise, false
+ */
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::handle::operator==(
+    const typename binomial_heap<T, Comp, Allocator>::handle& rhs
+) const { return index == rhs.index && generation == rhs.generation; }
 
 /**
- *  @brief      Copy constructor for nodes
- *  @param[in]  rhs node to be copied
+ *  @brief      Inequality operator for handles
+ *  @param[in]  rhs the handle to be compared with
+ *  @return     false if both handles were issued for the same element. Otherwise, true
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::node(
-    const typename binomial_heap<T, Comp>::node& rhs
-) { *this = rhs; }
-
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::handle::operator!=(
+    const typename binomial_heap<T, Comp, Allocator>::handle& rhs
+) const { return !(*this == rhs); }
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                            binomial_heap::handle_table implementation                            *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
 /**
- *  @brief      Move copy constructor for nodes
- *  @param[in]  rhs node to be copied
+ *  @brief      Constructor for handle tables
+ *  @param[in]  alloc the allocator the slots are requested from
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::node(
-    typename binomial_heap<T, Comp>::node&& rhs
-) { *this = std::move(rhs); }
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::handle_table::handle_table(const Allocator& alloc) :
+    entries(entry_allocator(alloc)),
+    free_head(no_handle) {}
 
 /**
- *  @brief      Assignment operator for nodes
- *  @param[in]  rhs node to be copied
- *  @return     this node by reference for operator chaining
+ *  @brief      Binds a free slot to a node, reusing released slots first. O(1) am. time.
+ *  @param[in]  target the node the slot is to refer to
+ *  @return     the index of the bound slot
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::node& binomial_heap<T, Comp>::node::operator=(
-    const typename binomial_heap<T, Comp>::node& rhs
+template<typename T, typename Comp, typename Allocator>
+uint32_t binomial_heap<T, Comp, Allocator>::handle_table::acquire(
+    typename binomial_heap<T, Comp, Allocator>::node* target
 ) {
-    if(this != &rhs) {
-        key = rhs.key;
-        delete_children();
-        children.clear();
-        for(node* child: rhs.children) children.push_back(new node(child));
-        parent = rhs.parent;
+    if(free_head != no_handle) {
+        uint32_t index = free_head;
+        free_head = entries[index].next_free;
+        entries[index].target = target;
+        return index;
     }
-    return *this;
+    if(entries.size() == no_handle) throw std::length_error("Handle table is full");
+    entries.push_back(entry{target, 0, no_handle});
+    return uint32_t(entries.size() - 1);
 }
 
 /**
- *  @brief      Move assignment operator for nodes
- *  @param[in]  rhs node to be copied
- *  @return     this node by reference for operator chaining
+ *  @brief      Unbinds a slot and bumps its generation so every handle issued for it goes stale
+ *  @param[in]  index the slot to be released
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::node& binomial_heap<T, Comp>::node::operator=(
-    typename binomial_heap<T, Comp>::node&& rhs
-) {
-    if(this != &rhs) {
-        delete_children();
-        children.clear();
-        key = std::move(rhs.key);
-        children = std::move(rhs.children);
-        parent = std::move(rhs.parent);
-    }
-    return *this;
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::handle_table::release(uint32_t index) {
+    entries[index].target = nullptr;
+    ++entries[index].generation;
+    entries[index].next_free = free_head;
+    free_head = index;
 }
-
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                binomial_heap::node implementation                                *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
 /**
- *  @brief      Destructor for nodes
+ *  @brief      Default constructor for nodes
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::node::~node() { delete_children(); }
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node::node() :
+    degree(0),
+    handle_slot(no_handle),
+    key(T()),
+    child(nullptr),
+    sibling(nullptr),
+    back(nullptr) {}
 
 /**
- *  @brief      Deletes all of a node's children
+ *  @brief      Constructs a node with provided key   
+ *  @param[in]  key the key of the node to be constructed
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::node::delete_children() {
-    for(node* child: children) delete child;
-    children.clear();
-    parent = nullptr;
-}
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node::node(const T& key) :
+    degree(0),
+    handle_slot(no_handle),
+    key(key),
+    child(nullptr),
+    sibling(nullptr),
+    back(nullptr) {}
+
+
+/**
+ *  @brief      Constructs a node with the provided key, by move
+ *  @param[in]  key the key of the node to be constructed
+*/
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node::node(T&& key) : 
+    degree(0),
+    handle_slot(no_handle),
+    key(std::forward<T>(key)),
+    child(nullptr),
+    sibling(nullptr),
+    back(nullptr) {}
 
 /**
  *  @brief      Searches for a node in this tree with a particular node. Time complexity is linear
@@ -231,37 +499,300 @@ void binomial_heap<T, Comp>::node::delete_children() {
  *              that value
  *              otherwise, nullptr
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::node* binomial_heap<T, Comp>::node::search(
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node* binomial_heap<T, Comp, Allocator>::node::search(
     const T& target,
     const Comp& compare
 ) {
     if(!compare(target, key) && !compare(key, target)) return this;
-    for(node* child: children) {
-        node* found = child->search(target, compare);
+    for(node* walker = child; walker; walker = walker->sibling) {
+        node* found = walker->search(target, compare);
         if(found) return found;
     }
     return nullptr;
 }
 
 /**
- *  @brief      Merges two trees in constant time, making the smaller of the two roots the new root
+ *  @brief      Constructs a node's key in place from arbitrary constructor arguments
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class...Args>
+binomial_heap<T, Comp, Allocator>::node::node(std::in_place_t, Args&&...args) :
+    degree(0),
+    handle_slot(no_handle),
+    key(std::forward<Args>(args)...),
+    child(nullptr),
+    sibling(nullptr),
+    back(nullptr) {}
+
+/**
+ *  @brief      Merges two trees in constant time, making the smaller of the two roots the new root.
+ *              On ties this node stays the root. The losing root becomes the first child of the
+ *              winner, so children are always ordered from highest to lowest degree.
  *  @param[in]  to_merge the other tree that this tree is to be merged with
  *  @return     The new root to the tree to be replaced in the list
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::node* binomial_heap<T, Comp>::node::promote(
-    binomial_heap<T, Comp>::node* to_merge,
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node* binomial_heap<T, Comp, Allocator>::node::promote(
+    binomial_heap<T, Comp, Allocator>::node* to_merge,
     const Comp& compare
 ) {
-    if(compare(key, to_merge->key)) {
-        children.push_back(to_merge);
-        to_merge->parent = this;
-        return this;
+    node* root = this;
+    if(compare(to_merge->key, key)) std::swap(root, to_merge);
+    to_merge->sibling = root->child;
+    to_merge->back = root;
+    if(root->child) root->child->back = to_merge;
+    root->child = to_merge;
+    ++root->degree;
+    return root;
+}
+
+/**
+ *  @brief  Finds the parent of this node. Only a first child links back to its parent; every
+ *          other child links back to its previous sibling. Because children are ordered from
+ *          highest to lowest degree, the walks made while sifting a node to the root add up to
+ *          O(log n) steps.
+ *  @return the parent of this node, or nullptr if this node is a root
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node*
+binomial_heap<T, Comp, Allocator>::node::parent() {
+    node* walker = this;
+    while(walker->back && walker->back->child != walker) walker = walker->back;
+    return walker->back;
+}
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                             binomial_heap::node_pool implementation                              *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructor for node pools. No memory is requested until the first allocation.
+ *  @param[in]  alloc the allocator slabs are requested from, rebound to slabs
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node_pool::node_pool(const Allocator& alloc) :
+    alloc(alloc),
+    slabs(nullptr),
+    last_slab(nullptr),
+    free_head(nullptr),
+    free_tail(nullptr),
+    bump_slab(nullptr),
+    bump(nullptr),
+    bump_end(nullptr),
+    free_count(0),
+    next_capacity(min_slab) {}
+
+/**
+ *  @brief      Move constructor for node pools. Takes ownership of every slab in rhs along with a
+ *              copy of its allocator.
+ *  @param[in]  rhs the pool whose slabs are to be moved
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node_pool::node_pool(
+    typename binomial_heap<T, Comp, Allocator>::node_pool&& rhs
+) :
+    node_pool(rhs.alloc) { *this = std::move(rhs); }
+
+/**
+ *  @brief      Move assignment operator for node pools. Releases this pool's slabs and takes
+ *              ownership of every slab in rhs. This pool keeps its own allocator, which must
+ *              compare equal to the allocator of rhs.
+ *  @param[in]  rhs the pool whose slabs are to be moved
+ *  @return     this pool by reference for operator chaining
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node_pool&
+binomial_heap<T, Comp, Allocator>::node_pool::operator=(
+    typename binomial_heap<T, Comp, Allocator>::node_pool&& rhs
+) {
+    if(this != &rhs) {
+        release();
+        std::swap(slabs, rhs.slabs);
+        std::swap(last_slab, rhs.last_slab);
+        std::swap(free_head, rhs.free_head);
+        std::swap(free_tail, rhs.free_tail);
+        std::swap(bump_slab, rhs.bump_slab);
+        std::swap(bump, rhs.bump);
+        std::swap(bump_end, rhs.bump_end);
+        std::swap(free_count, rhs.free_count);
+        std::swap(next_capacity, rhs.next_capacity);
+    }
+    return *this;
+}
+
+/**
+ *  @brief  Destructor for node pools. Nodes still living in the pool are not destroyed.
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::node_pool::~node_pool() { release(); }
+
+/**
+ *  @brief  Hands out storage for one node, reusing the most recently freed node if there is one.
+ *          O(1) time; requests a new slab from the system only when the pool is exhausted.
+ *  @return uninitialized storage for a node
+ */
+template<typename T, typename Comp, typename Allocator>
+void* binomial_heap<T, Comp, Allocator>::node_pool::allocate() {
+    if(free_head) {
+        slot* reused = free_head;
+        free_head = reused->next_free;
+        if(!free_head) free_tail = nullptr;
+        --free_count;
+        return &reused->value;
+    }
+    if(bump == bump_end) add_slab();
+    return &(bump++)->value;
+}
+
+/**
+ *  @brief      Requests a dedicated slab holding exactly count contiguous nodes, for bulk builds
+ *  @param[in]  count the number of nodes in the block, must be nonzero
+ *  @return     uninitialized storage for count nodes, addressable as an array
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node*
+binomial_heap<T, Comp, Allocator>::node_pool::allocate_block(
+    size_t count
+) {
+    static_assert(sizeof(slot) == sizeof(node), "slots must be laid out like an array of nodes");
+    slot_allocator slab_alloc(alloc);
+    slot* added = slot_traits::allocate(slab_alloc, count + 1);
+    new(&added->header) slab_header{slabs, count, count};
+    if(!slabs) last_slab = added;
+    slabs = added;
+    return reinterpret_cast<node*>(added + 1);
+}
+
+/**
+ *  @brief  Counts the nodes allocate() can hand out before it has to request a new slab
+ *  @return the number of free nodes plus the untouched slots left in the current slab
+ */
+template<typename T, typename Comp, typename Allocator>
+size_t binomial_heap<T, Comp, Allocator>::node_pool::spare() const {
+    return free_count + size_t(bump_end - bump);
+}
+
+/**
+ *  @brief      Returns the storage of an already destroyed node to the free list
+ *  @param[in]  target the node whose storage is to be recycled
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::node_pool::deallocate(
+    typename binomial_heap<T, Comp, Allocator>::node* target
+) {
+    slot* freed = reinterpret_cast<slot*>(target);
+    freed->next_free = free_head;
+    if(!free_head) free_tail = freed;
+    free_head = freed;
+    ++free_count;
+}
+
+/**
+ *  @brief          Takes ownership of every slab and free node in rhs, leaving rhs empty. The
+ *                  allocators of both pools must compare equal. O(1) time.
+ *  @param[in, out] rhs the pool to be emptied into this pool
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::node_pool::splice(
+    typename binomial_heap<T, Comp, Allocator>::node_pool& rhs
+) {
+    if(this == &rhs || !rhs.slabs) return;
+    if(rhs.bump_slab) rhs.bump_slab->header.used = rhs.bump - (rhs.bump_slab + 1);
+    if(last_slab) last_slab->header.next = rhs.slabs;
+    else slabs = rhs.slabs;
+    last_slab = rhs.last_slab;
+    if(rhs.free_head) {
+        if(free_tail) free_tail->next_free = rhs.free_head;
+        else free_head = rhs.free_head;
+        free_tail = rhs.free_tail;
+    }
+    free_count += rhs.free_count;
+    rhs.free_count = 0;
+    rhs.slabs = rhs.last_slab = rhs.free_head = rhs.free_tail = nullptr;
+    rhs.bump_slab = rhs.bump = rhs.bump_end = nullptr;
+    rhs.next_capacity = min_slab;
+}
+
+/**
+ *  @brief  Returns every slab to the system in O(number of slabs) time. Nodes still living in the
+ *          pool are not destroyed.
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::node_pool::release() {
+    while(slabs) {
+        slot* next = slabs->header.next;
+        size_t capacity = slabs->header.capacity;
+        slabs->header.~slab_header();
+        slot_allocator slab_alloc(alloc);
+        slot_traits::deallocate(slab_alloc, slabs, capacity + 1);
+        slabs = next;
+    }
+    last_slab = free_head = free_tail = bump_slab = bump = bump_end = nullptr;
+    free_count = 0;
+    next_capacity = min_slab;
+}
+
+/**
+ *  @brief      Calls a visitor on every node in the pool, slab by slab in allocation order. Free
+ *              slots are first tagged through the leading byte they share with a node's degree,
+ *              which no node can reach, so the free list is consumed and the pool must be released
+ *              afterwards. Slots past a slab's high-water mark were never handed out and are
+ *              skipped. O(slots) time, with no recursion or pointer chasing through trees.
+ *  @param[in]  visit the function to be called with each live node
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class Visitor>
+void binomial_heap<T, Comp, Allocator>::node_pool::drain(Visitor visit) {
+    for(slot* vacant = free_head; vacant;) {
+        slot* next = vacant->next_free;
+        *reinterpret_cast<unsigned char*>(vacant) = vacant_tag;
+        vacant = next;
+    }
+    free_head = free_tail = nullptr;
+    free_count = 0;
+    for(slot* slab = slabs; slab; slab = slab->header.next) {
+        size_t used = slab == bump_slab ? size_t(bump - (slab + 1)) : slab->header.used;
+        for(slot* walker = slab + 1; walker != slab + 1 + used; ++walker)
+            if(*reinterpret_cast<const unsigned char*>(walker) != vacant_tag) visit(&walker->value);
     }
-    to_merge->children.push_back(this);
-    parent = to_merge;
-    return to_merge;
+}
+
+/**
+ *  @brief  Gets the allocator slabs are requested from
+ *  @return the allocator of the pool, by reference
+ */
+template<typename T, typename Comp, typename Allocator>
+const Allocator& binomial_heap<T, Comp, Allocator>::node_pool::allocator() const { return alloc; }
+
+/**
+ *  @brief      Replaces the allocator of a pool that holds no slabs
+ *  @param[in]  alloc the allocator future slabs are to be requested from
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::node_pool::adopt_allocator(const Allocator& alloc) {
+    this->alloc = alloc;
+}
+
+/**
+ *  @brief  Requests a new slab from the system, doubling the slab size up to max_slab nodes. The
+ *          first slot of every slab holds its header.
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::node_pool::add_slab() {
+    slot_allocator slab_alloc(alloc);
+    slot* added = slot_traits::allocate(slab_alloc, next_capacity + 1);
+    new(&added->header) slab_header{slabs, next_capacity, next_capacity};
+    if(!slabs) last_slab = added;
+    slabs = added;
+    bump_slab = added;
+    bump = added + 1;
+    bump_end = bump + next_capacity;
+    next_capacity = std::min(next_capacity * 2, max_slab);
 }
 
 /***************************************************************************************************
@@ -274,91 +805,200 @@ typename binomial_heap<T, Comp>::node* binomial_heap<T, Comp>::node::promote(
 /**
  *  @brief      Default constructor for the binomial_heap class
  *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ *  @param[in]  mode merge_mode::lazy makes insert() and merge() only splice roots and defers all
+ *              consolidation to the next extract(). Defaults to merge_mode::eager.
+ *  @param[in]  alloc the allocator for nodes and handles, defaults to Allocator()
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::binomial_heap(const Comp& compare) : 
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(
+    const Comp& compare,
+    merge_mode mode,
+    const Allocator& alloc
+) : 
     compare(compare),
+    pool(alloc),
+    trees(),
+    occupied(0),
+    pending(nullptr),
+    pending_tail(nullptr),
+    lazy(mode == merge_mode::lazy),
+    live_handles(0),
     _min(nullptr),
     _size(0) {}
 
+/**
+ *  @brief      Constructs an empty eager heap with a default comparison functor
+ *  @param[in]  alloc the allocator for nodes and handles
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(const Allocator& alloc) :
+    binomial_heap(Comp(), merge_mode::eager, alloc) {}
+
 /**
  *  @brief      Range constructor for the binomial_heap class
  *  @param[in]  start the beginning of the range to be inserted into the heap
  *  @param[in]  stop the end of the range to be inserted into the heap
  *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ *  @param[in]  alloc the allocator for nodes and handles, defaults to Allocator()
  */
-template<typename T, typename Comp>
+template<typename T, typename Comp, typename Allocator>
 template<class InputIterator>
-binomial_heap<T, Comp>::binomial_heap(
+binomial_heap<T, Comp, Allocator>::binomial_heap(
     InputIterator start,
     InputIterator stop,
-    const Comp& compare
-) : compare(compare), _min(nullptr), _size(0) { multi_insert(start, stop); }
+    const Comp& compare,
+    const Allocator& alloc
+) : binomial_heap(compare, merge_mode::eager, alloc) { multi_insert(start, stop); }
 
 /**
- *  @brief      Copy constructor for the binomial_heap class. Performs a deep copy.
+ *  @brief      Copy constructor for the binomial_heap class. Performs a deep copy into memory
+ *              from the allocator selected by select_on_container_copy_construction.
  *  @param[in]  rhs the binomial_heap whose contents are to be copied
  */
-template<typename T,  typename Comp>
-binomial_heap<T, Comp>::binomial_heap(const binomial_heap<T, Comp>& rhs) { this->operator=(rhs); }
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(const binomial_heap<T, Comp, Allocator>& rhs) :
+    binomial_heap(
+        rhs.compare,
+        merge_mode::eager,
+        alloc_traits::select_on_container_copy_construction(rhs.get_allocator())
+    ) { copy_from(rhs); }
+
+/**
+ *  @brief      Allocator-extended copy constructor. Performs a deep copy into memory from alloc.
+ *  @param[in]  rhs the binomial_heap whose contents are to be copied
+ *  @param[in]  alloc the allocator for nodes and handles
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(
+    const binomial_heap<T, Comp, Allocator>& rhs,
+    const Allocator& alloc
+) : binomial_heap(rhs.compare, merge_mode::eager, alloc) { copy_from(rhs); }
+
+/**
+ *  @brief      Move constructor for the binomial_heap class. Takes over the nodes of rhs along with
+ *              a copy of its allocator.
+ *  @param[in]  rhs the binomial_heap whose contents are to be moved
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(
+    binomial_heap<T, Comp, Allocator>&& rhs
+) noexcept : binomial_heap(rhs.compare, merge_mode::eager, rhs.get_allocator()) { move_from(rhs); }
 
 /**
- *  @brief      Move constructor for the binomial_heap class
+ *  @brief      Allocator-extended move constructor. Takes over the nodes of rhs if alloc compares
+ *              equal to its allocator, and otherwise moves every key into nodes from alloc.
  *  @param[in]  rhs the binomial_heap whose contents are to be moved
+ *  @param[in]  alloc the allocator for nodes and handles
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::binomial_heap(binomial_heap<T, Comp>&& rhs) { this->operator=(rhs); }
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::binomial_heap(
+    binomial_heap<T, Comp, Allocator>&& rhs,
+    const Allocator& alloc
+) : binomial_heap(rhs.compare, merge_mode::eager, alloc) { move_from(rhs); }
 
 /**
- *  @brief      Assignment operator for the binomial_heap class. Performs a deep copy.
+ *  @brief      Assignment operator for the binomial_heap class. Performs a deep copy, first
+ *              adopting the allocator of rhs if propagate_on_container_copy_assignment is set.
  *  @param[in]  rhs the binomial_heap to be copied
  *  @return     this binomial_heap by reference for operator chaining
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>& binomial_heap<T, Comp>::operator=(const binomial_heap<T, Comp>& rhs) {
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>&
+binomial_heap<T, Comp, Allocator>::operator=(const binomial_heap<T, Comp, Allocator>& rhs) {
+    if(this == &rhs) return *this;
     delete_trees();
-    compare = rhs.compare;
-    _size = rhs._size;
-    for(node* tree: rhs.trees) { trees.push_back(new node(*tree)); }
-    set_min();
+    if constexpr(alloc_traits::propagate_on_container_copy_assignment::value)
+        pool.adopt_allocator(rhs.get_allocator());
+    copy_from(rhs);
     return *this;
 }
 
 /**
- *  @brief      Move assignment operator for the binomial_heap class.
+ *  @brief      Move assignment operator for the binomial_heap class. Takes over the nodes of rhs
+ *              if propagate_on_container_move_assignment is set or the allocators compare equal.
+ *              Otherwise every key is moved into nodes from this heap's allocator.
  *  @param[in]  rhs the binomial_heap to be moved
  *  @return     this binomial_heap by reference for operator chaining
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>& binomial_heap<T, Comp>::operator=(binomial_heap<T, Comp>&& rhs) {
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>& binomial_heap<T, Comp, Allocator>::operator=(
+    binomial_heap<T, Comp, Allocator>&& rhs
+) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value
+) {
+    if(this == &rhs) return *this;
     delete_trees();
-    compare = std::move(rhs.compare);
-    trees = std::move(rhs.trees);
-    _min = std::move(rhs._min);
-    _size = std::move(rhs._size);
+    if constexpr(alloc_traits::propagate_on_container_move_assignment::value)
+        pool.adopt_allocator(rhs.get_allocator());
+    move_from(rhs);
     return *this;
 }
 
 /**
  *  @brief  Destructor for the binomial_heap class
  */
-template<typename T, typename Comp>
-binomial_heap<T, Comp>::~binomial_heap() { delete_trees(); }
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator>::~binomial_heap() { delete_trees(); }
+
+/**
+ *  @brief  Removes every element from the heap and returns its nodes to the allocator. Handles
+ *          to the removed elements become stale. O(n) time, or O(number of slabs) time if T is
+ *          trivially destructible and no element has a live handle.
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::clear() { delete_trees(); }
+
+/**
+ *  @brief  Gets a copy of the allocator nodes and handles are requested from
+ *  @return the allocator of the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+Allocator binomial_heap<T, Comp, Allocator>::get_allocator() const { return pool.allocator(); }
+
+/**
+ *  @brief      Makes a deep copy of the heap, like the copy constructor, but lets a large heap of
+ *              trivially copyable keys be cloned on several threads, one group of trees per thread
+ *  @param[in]  threads the maximum number of threads to clone with, defaults to the number of
+ *              hardware threads
+ *  @return     the copy
+ */
+template<typename T, typename Comp, typename Allocator>
+binomial_heap<T, Comp, Allocator> binomial_heap<T, Comp, Allocator>::clone(size_t threads) const {
+    if(!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+    binomial_heap copy(
+        compare,
+        merge_mode::eager,
+        alloc_traits::select_on_container_copy_construction(get_allocator())
+    );
+    copy.copy_from(*this, threads);
+    return copy;
+}
 
 /**
  *  @brief  Gets the size of the heap
  *  @return the size of the heap
  */
-template<typename T, typename Comp>
-size_t binomial_heap<T, Comp>::size() const { return _size; }
+template<typename T, typename Comp, typename Allocator>
+size_t binomial_heap<T, Comp, Allocator>::size() const { return _size; }
 
 /**
  *  @brief  Returns whether or not the heap is empty
  *  @return true if the heap has zero elements. Otherwise,
  *          false
  */
-template<typename T, typename Comp>
-bool binomial_heap<T, Comp>::empty() const { return !_size; }
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::empty() const { return !_size; }
+
+/**
+ *  @brief  Returns whether the heap consolidates its roots eagerly or lazily
+ *  @return the merge_mode the heap was constructed or assigned with
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::merge_mode
+binomial_heap<T, Comp, Allocator>::mode() const {
+    return lazy ? merge_mode::lazy : merge_mode::eager;
+}
 
 /**
  *  @brief      Finds the first occurrence of a certain key in the heap by iterating through
@@ -366,107 +1006,184 @@ bool binomial_heap<T, Comp>::empty() const { return !_size; }
  *  @param[in]  key the key to be searched for in the heap
  *  @return     an iterator containing the element that was searched for in the heap
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::iterator binomial_heap<T, Comp>::find(T key) const {
-    for(node* tree: trees) {
-        node* found = tree->search(key);
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::iterator
+binomial_heap<T, Comp, Allocator>::find(const T& key) const {
+    for(uint64_t mask = occupied; mask; mask &= mask - 1) {
+        node* found = trees[lowest_degree(mask)]->search(key, compare);
+        if(found) return iterator(found);
+    }
+    for(node* tree = pending; tree; tree = tree->sibling) {
+        node* found = tree->search(key, compare);
         if(found) return iterator(found);
     }
-    throw new std::out_of_range("Key not found");
+    throw std::out_of_range("Key not found");
+}
+
+/**
+ *  @brief      Calls a visitor on every key in the heap, in no particular order. O(n) time.
+ *  @param[in]  visit the function to be called with each key, by const reference
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class Visitor>
+void binomial_heap<T, Comp, Allocator>::for_each(Visitor visit) const {
+    for(uint64_t mask = occupied; mask; mask &= mask - 1)
+        visit_tree(trees[lowest_degree(mask)], visit);
+    for(const node* tree = pending; tree; tree = tree->sibling) visit_tree(tree, visit);
 }
 
 /**
  *  @brief  Gets the value of the minimum element in the heap
  *  @return the value of the minimum element in the heap.
  */
-template<typename T, typename Comp>
-T binomial_heap<T, Comp>::min() const {
+template<typename T, typename Comp, typename Allocator>
+T binomial_heap<T, Comp, Allocator>::min() const { return top(); }
+
+/**
+ *  @brief  Gets the minimum element in the heap without copying it. The reference stays valid
+ *          until that element leaves the heap or its key is decreased.
+ *  @return a reference to the minimum element in the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+const T& binomial_heap<T, Comp, Allocator>::top() const {
     if(_min) return _min->key;
-    throw new std::out_of_range("Empty");
+    throw std::out_of_range("Empty");
 }
 
 /**
- *  @brief  Extracts the minimum element from the heap. O(log n) time.
+ *  @brief  Extracts the minimum element from the heap. O(log n) time, plus the deferred
+ *          consolidation of every root spliced in since the last extract() in lazy mode.
  *  @return the value of the minimum element in the heap.
  */
-template<typename T, typename Comp>
-T binomial_heap<T, Comp>::extract() {
-    T min_val = _min->key;
-    trees.remove(_min);
-    merge_lists(std::move(_min->children));
-    _min->children = std::list<node*>();
-    delete _min;
-    set_min();
-    --_size;
+template<typename T, typename Comp, typename Allocator>
+T binomial_heap<T, Comp, Allocator>::extract() { return pop(); }
+
+/**
+ *  @brief  Extracts the minimum element from the heap, moving its key out instead of copying it.
+ *          Same time complexity as extract().
+ *  @return the minimum element in the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+T binomial_heap<T, Comp, Allocator>::pop() {
+    if(!_min) throw std::out_of_range("Empty");
+    consolidate();
+    T min_val = std::move(_min->key);
+    remove_root(_min);
     return min_val;
 }
 
 /**
- *  @brief          Merges two heaps, emptying the passed heap. O(log n) time.
- *  @param[in, out] rhs the heap to be emptied and merged with this heap
+ *  @brief  Extracts the minimum element from the heap if there is one. Never throws on an empty
+ *          heap.
+ *  @return the minimum element moved out of the heap, or std::nullopt if the heap is empty
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::merge(binomial_heap<T, Comp>& rhs) {
-    auto comp_copy = rhs.compare;
-    merge(std::move(rhs));
-    rhs = binomial_heap(comp_copy);
+template<typename T, typename Comp, typename Allocator>
+std::optional<T> binomial_heap<T, Comp, Allocator>::try_extract() {
+    if(!_min) return std::nullopt;
+    consolidate();
+    std::optional<T> min_val(std::move(_min->key));
+    remove_root(_min);
+    return min_val;
 }
 
 /**
- * @brief       Merges two heaps, destroying the passed heap. O(log n) time.
+ *  @brief          Merges two heaps, emptying the passed heap. O(log n) time, or O(1) in lazy
+ *                  mode when rhs is also lazy. Handles of either heap stay valid, provided that
+ *                  at most one of the heaps has live handles or both issue them from one table
+ *                  through share_handles(). Otherwise std::invalid_argument is thrown and neither
+ *                  heap is changed.
+ *  @param[in, out] rhs the heap to be emptied and merged with this heap
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::merge(
+    binomial_heap<T, Comp, Allocator>& rhs
+) { merge(std::move(rhs)); }
+
+/**
+ * @brief       Merges two heaps, destroying the passed heap. O(log n) time, or O(1) in lazy
+ *              mode when rhs is also lazy. Handles of either heap stay valid, provided that at
+ *              most one of the heaps has live handles or both issue them from one table through
+ *              share_handles(). Otherwise std::invalid_argument is thrown and neither heap is
+ *              changed.
  * @param[in]   rhs the heap to be merged with this heap
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::merge(binomial_heap<T, Comp>&& rhs) {
-    _size += rhs._size;
-    if(compare(rhs._min->key, _min->key)) _min = rhs._min;
-    merge_lists(std::forward<std::list<node*>>(rhs.trees));
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::merge(binomial_heap<T, Comp, Allocator>&& rhs) {
+    splice_roots(rhs);
+    if(!lazy) consolidate();
+}
+
+/**
+ *  @brief          Merges a range of heaps into this heap, emptying them. Pairs of heaps are
+ *                  merged in parallel, level by level as in a reduction tree, until there are no
+ *                  more partial heaps than threads. The roots of those are then spliced into this
+ *                  heap and consolidated in a single degree-bucketed pass, or left pending in lazy
+ *                  mode. Handle tables are not synchronized, so if any heap has live handles the
+ *                  pairs are merged on the calling thread instead. If a merge throws, every element
+ *                  is still owned by some heap.
+ *  @param[in]      first the beginning of the range of heaps to be merged
+ *  @param[in]      last the end of the range of heaps to be merged
+ *  @param[in]      threads the maximum number of threads to merge with, defaults to the number of
+ *                  hardware threads
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class ForwardIterator>
+void binomial_heap<T, Comp, Allocator>::merge_all(
+    ForwardIterator first,
+    ForwardIterator last,
+    size_t threads
+) {
+    std::vector<binomial_heap*> parts;
+    bool handled = live_handles;
+    for(; first != last; ++first) {
+        if(&*first == this || first->empty()) continue;
+        parts.push_back(&*first);
+        handled = handled || first->live_handles;
+    }
+    if(!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+    if(handled) threads = 1;
+    while(threads > 1 && parts.size() > threads) {
+        size_t pairs = parts.size() / 2;
+        size_t per_task = (pairs + threads - 1) / threads;
+        std::vector<std::future<void>> tasks;
+        for(size_t begin = 0; begin < pairs; begin += per_task) {
+            size_t end = std::min(pairs, begin + per_task);
+            tasks.push_back(std::async(std::launch::async, [&parts, begin, end] {
+                for(size_t i = begin; i < end; ++i) parts[2 * i]->merge(*parts[2 * i + 1]);
+            }));
+        }
+        for(std::future<void>& task: tasks) task.get();
+        for(size_t i = 0; i < pairs; ++i) parts[i] = parts[2 * i];
+        if(parts.size() % 2) parts[pairs] = parts.back();
+        parts.resize((parts.size() + 1) / 2);
+    }
+    for(binomial_heap* part: parts) splice_roots(*part);
+    if(!lazy) consolidate();
 }
 
 /**
  *  @brief      Inserts a key into the heap. O(1) am. time
  *  @param[in]  key the key to be inserted into the heap
- *  @return     an iterator containing the node that was just inserted into the heap
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::insert(const T& key) {
-    ++_size;
-    node* new_tree = new node(key);
-    trees.push_front(new_tree);
-    if(!_min) _min = new_tree;
-    else if(compare(new_tree->key, key)) { _min = new_tree; }
-    fast_zip();
-}
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::insert(const T& key) { iter_insert(key); }
 
 /**
  *  @brief      Inserts a key into the heap. O(1) am. time
  *  @param[in]  key the key to be inserted into the heap
- *  @return     an iterator containing the node that was just inserted into the heap
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::insert(T&& key) {
-    ++_size;
-    node* new_tree = new node(std::forward<T>(key));
-    trees.push_front(new_tree);
-    if(!_min) _min = new_tree;
-    else if(compare(new_tree->key, key)) { _min = new_tree; }
-    fast_zip();
-}
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::insert(T&& key) { iter_insert(std::move(key)); }
 
 /**
  *  @brief      Inserts a key into the heap. O(1) am. time and returns an iterator
  *  @param[in]  key the key to be inserted into the heap
  *  @return     an iterator containing the node that was just inserted into the heap
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::iterator binomial_heap<T, Comp>::iter_insert(const T& key) {
-    ++_size;
-    node* new_tree = new node(key);
-    trees.push_front(new_tree);
-    if(!_min) _min = new_tree;
-    else if(compare(new_tree->key, key)) { _min = new_tree; }
-    fast_zip();
-    return iterator(new_tree);
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::iterator
+binomial_heap<T, Comp, Allocator>::iter_insert(const T& key) {
+    return insert_node(create_node(key));
 }
 
 /**
@@ -474,47 +1191,51 @@ typename binomial_heap<T, Comp>::iterator binomial_heap<T, Comp>::iter_insert(co
  *  @param[in]  key the key to be inserted into the heap
  *  @return     an iterator containing the node that was just inserted into the heap
  */
-template<typename T, typename Comp>
-typename binomial_heap<T, Comp>::iterator binomial_heap<T, Comp>::iter_insert(T&& key) {
-    ++_size;
-    node* new_tree = new node(std::forward<T>(key));
-    trees.push_front(new_tree);
-    if(!_min) _min = new_tree;
-    else if(compare(new_tree->key, key)) { _min = new_tree; }
-    fast_zip();
-    return iterator(new_tree);
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::iterator
+binomial_heap<T, Comp, Allocator>::iter_insert(T&& key) {
+    return insert_node(create_node(std::move(key)));
 }
 
 /**
- *  @brief      Emplaces a key onto the heap and returns an iterator to it
+ *  @brief      Emplaces a key onto the heap and returns an iterator to it. The key is constructed
+ *              directly inside its node.
  * 
- *  @param[in]  ...args parameter list for the constructor for T
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
  *  @return     an iterator to the node containing the inserted key
  */
-template<typename T, typename Comp>
+template<typename T, typename Comp, typename Allocator>
 template<class...Args>
-typename binomial_heap<T, Comp>::iterator binomial_heap<T, Comp>::iter_emplace(Args&&...args) {
-    return iter_insert(T(args...));
+typename binomial_heap<T, Comp, Allocator>::iterator
+binomial_heap<T, Comp, Allocator>::iter_emplace(Args&&...args) {
+    return insert_node(create_node(std::in_place, std::forward<Args>(args)...));
 }
 
 /**
- * @brief       Emplaces a key onto the heap
+ * @brief       Emplaces a key onto the heap. The key is constructed directly inside its node.
  * 
- * @param[in]   ...args parameter list for the constructor for T
+ * @param[in]   ...args parameter list for the constructor for T, perfectly forwarded
  */
-template<typename T, typename Comp>
+template<typename T, typename Comp, typename Allocator>
 template<class...Args>
-void binomial_heap<T, Comp>::emplace(Args&&...args) { insert(T(args...)); }
+void binomial_heap<T, Comp, Allocator>::emplace(Args&&...args) {
+    insert_node(create_node(std::in_place, std::forward<Args>(args)...));
+}
 
 /**
  *  @brief      Inserts a range of elements into the heap
  *  @param[in]  start the beginning of the range to be inserted into the heap
  *  @param[in]  stop the end of the range to be inserted into the heap
  */
-template<typename T, typename Comp>
+template<typename T, typename Comp, typename Allocator>
 template<class InputIterator>
-void binomial_heap<T, Comp>::multi_insert(InputIterator start, InputIterator stop) {
-    for(; start != stop; ++start) insert(*start);
+void binomial_heap<T, Comp, Allocator>::multi_insert(InputIterator start, InputIterator stop) {
+    bulk_insert(
+        start,
+        stop,
+        typename std::iterator_traits<InputIterator>::iterator_category(),
+        nullptr
+    );
 }
 
 /**
@@ -524,111 +1245,916 @@ void binomial_heap<T, Comp>::multi_insert(InputIterator start, InputIterator sto
  *  @return     a vector containing the respective iterators for each of the elements that were
  *              inserted into the heap.
  */
-template<typename T, typename Comp>
+template<typename T, typename Comp, typename Allocator>
 template<class InputIterator>
-std::vector<typename binomial_heap<T, Comp>::iterator> binomial_heap<T, Comp>::iter_multi_insert(
+std::vector<typename binomial_heap<T, Comp, Allocator>::iterator>
+binomial_heap<T, Comp, Allocator>::iter_multi_insert(
     InputIterator start,
     InputIterator stop
 ) {
     std::vector<iterator> iters;
-    for(; start != stop; ++start) iters.push_back(iter_insert(*start));
+    bulk_insert(
+        start,
+        stop,
+        typename std::iterator_traits<InputIterator>::iterator_category(),
+        &iters
+    );
     return iters;
 }
 
 /**
- *  @brief          Decreases the key of the node contained within the passed iterator. If the
- *                  key passed in is equivalent to an existing key within the tree of the 
- *                  referenced node, the referenced node will bubble above the existing equivalent
- *                  node (for remove()). O(log n) time.
+ *  @brief      Inserts a single-pass range one element at a time
+ *  @param[in]  start the beginning of the range to be inserted into the heap
+ *  @param[in]  stop the end of the range to be inserted into the heap
+ *  @param[out] iters if not nullptr, receives an iterator for each inserted element
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class InputIterator>
+void binomial_heap<T, Comp, Allocator>::bulk_insert(
+    InputIterator start,
+    InputIterator stop,
+    std::input_iterator_tag,
+    std::vector<typename binomial_heap<T, Comp, Allocator>::iterator>* iters
+) {
+    for(; start != stop; ++start) {
+        iterator inserted = iter_insert(*start);
+        if(iters) iters->push_back(inserted);
+    }
+}
+
+/**
+ *  @brief      Inserts a range of known size with build_forest(). Linear time, at most one
+ *              allocation and fewer than n comparisons for n elements.
+ *  @param[in]  start the beginning of the range to be inserted into the heap
+ *  @param[in]  stop the end of the range to be inserted into the heap
+ *  @param[out] iters if not nullptr, receives an iterator for each inserted element
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class ForwardIterator>
+void binomial_heap<T, Comp, Allocator>::bulk_insert(
+    ForwardIterator start,
+    ForwardIterator stop,
+    std::forward_iterator_tag,
+    std::vector<typename binomial_heap<T, Comp, Allocator>::iterator>* iters
+) {
+    size_t count = std::distance(start, stop);
+    if(!count) return;
+    if(iters) iters->reserve(iters->size() + count);
+    build_forest(start, count, iters);
+}
+
+/**
+ *  @brief      Builds count elements bottom-up. Each node is linked into a local forest like a
+ *              carry in a binary counter, which leaves exactly one binomial tree per set bit of
+ *              count, and that forest is then merged into the heap. Nodes are taken from the pool
+ *              while it has spare ones, so freed nodes are reused, and the rest come from one new
+ *              block.
+ *  @param[in]  start the beginning of the elements to be inserted
+ *  @param[in]  count the number of elements to be inserted
+ *  @param[out] iters if not nullptr, receives an iterator for each inserted element, in order
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class ForwardIterator>
+void binomial_heap<T, Comp, Allocator>::build_forest(
+    ForwardIterator start,
+    size_t count,
+    std::vector<typename binomial_heap<T, Comp, Allocator>::iterator>* iters
+) {
+    size_t pooled = std::min(count, pool.spare());
+    node* block = pooled < count ? pool.allocate_block(count - pooled) : nullptr;
+    node* forest[max_degree];
+    uint64_t mask = 0;
+    size_t built = 0;
+    try {
+        for(; built < count; ++built, ++start) {
+            node* created = built < pooled
+                ? create_node(*start)
+                : new(block + built - pooled) node(*start);
+            if(iters) iters->push_back(iterator(created));
+            add_tree(forest, mask, created);
+        }
+    } catch(...) {
+        if(iters) iters->resize(iters->size() - built);
+        for(; mask; mask &= mask - 1) destroy_tree(forest[lowest_degree(mask)]);
+        for(size_t i = std::max(built, pooled); i < count; ++i) pool.deallocate(block + i - pooled);
+        throw;
+    }
+    node* forest_min = nullptr;
+    for(uint64_t bits = mask; bits; bits &= bits - 1) {
+        node* tree = forest[lowest_degree(bits)];
+        if(!forest_min || compare(tree->key, forest_min->key)) forest_min = tree;
+    }
+    _size += count;
+    if(!_min || compare(forest_min->key, _min->key)) _min = forest_min;
+    for(; mask; mask &= mask - 1) add_root(forest[lowest_degree(mask)]);
+}
+
+/**
+ *  @brief          Decreases the key of the node contained within the passed iterator, sifting the
+ *                  node up by swapping it with its parent. Nodes change places instead of keys, so
+ *                  every iterator stays attached to its key. O(log n) time.
  *  @param[in, out] it an iterator containing the node whose key is to be decreased
- *  @param[in]      new_key the value the key is to be decreased to
+ *  @param[in]      new_key the value the key is to be decreased to. Must not compare greater than
+ *                  the current key.
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::decrease_key(
-    const binomial_heap<T, Comp>::iterator& it,
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::decrease_key(
+    const binomial_heap<T, Comp, Allocator>::iterator& it,
     T new_key
 ) {
-    if(!compare(new_key, it.data->key)) throw new std::invalid_argument("Invalid new key.");
-    node* walker = it.data;
-    walker->key = new_key;
-    while(walker->parent && compare(new_key, walker->parent->key)) {
-        //swap lists and transfer parent into swapped this list
-        //degree is index in parent listfv
-        walker->parent = walker->parent->parent;
+    node* target = it.data;
+    if(compare(target->key, new_key)) throw std::invalid_argument("Invalid new key.");
+    consolidate();
+    target->key = std::move(new_key);
+    for(node* parent = target->parent(); parent; parent = target->parent()) {
+        if(!compare(target->key, parent->key)) return;
+        if(parent == _min) _min = target;
+        swap_with_parent(target, parent);
     }
+    root_keys.store(target->degree, target->key);
+    if(compare(target->key, _min->key)) _min = target;
 }
 
 /**
- *  @brief      Removes the specified element from the heap
+ *  @brief      Removes the specified element from the heap by swapping it up to the root of its
+ *              tree, as if its key were smaller than every other key, and then removing that
+ *              root. Never compares against the removed key. O(log n) time.
  *  @param[in]  it iterator of the element that is to be removed
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::remove(typename binomial_heap<T, Comp>::iterator&& it) {
-    decrease_key(it, _min->key);
-    extract();
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::remove(
+    const typename binomial_heap<T, Comp, Allocator>::iterator& it
+) {
+    consolidate();
+    node* target = it.data;
+    for(node* parent = target->parent(); parent; parent = target->parent())
+        swap_with_parent(target, parent);
+    remove_root(target);
+}
+
+/**
+ *  @brief      Inserts a key into the heap. O(1) am. time and returns a handle to it
+ *  @param[in]  key the key to be inserted into the heap
+ *  @return     a handle to the element that was just inserted into the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::handle
+binomial_heap<T, Comp, Allocator>::handle_insert(const T& key) {
+    return get_handle(iter_insert(key));
+}
+
+/**
+ *  @brief      Inserts a key into the heap. O(1) am. time and returns a handle to it
+ *  @param[in]  key the key to be inserted into the heap
+ *  @return     a handle to the element that was just inserted into the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::handle
+binomial_heap<T, Comp, Allocator>::handle_insert(T&& key) {
+    return get_handle(iter_insert(std::move(key)));
+}
+
+/**
+ *  @brief      Emplaces a key onto the heap and returns a handle to it
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
+ *  @return     a handle to the element that was just inserted into the heap
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class...Args>
+typename binomial_heap<T, Comp, Allocator>::handle
+binomial_heap<T, Comp, Allocator>::handle_emplace(Args&&...args) {
+    return get_handle(iter_emplace(std::forward<Args>(args)...));
+}
+
+/**
+ *  @brief      Writes the heap to a binary snapshot that load() can restore. Trees are written in
+ *              degree order and each tree's keys in preorder, packed contiguously and aligned for
+ *              T after a short header, so the shape of every tree is implied by its degree. The
+ *              snapshot uses the native byte order and key layout, so it is only portable between
+ *              builds that agree on both. Handles are not saved. O(n) time.
+ *  @param[in]  out the stream the snapshot is to be written to
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::save(std::ostream& out) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshots need trivially copyable keys");
+    std::vector<unsigned char> degrees;
+    for(uint64_t mask = occupied; mask; mask &= mask - 1) degrees.push_back(lowest_degree(mask));
+    for(const node* tree = pending; tree; tree = tree->sibling) degrees.push_back(tree->degree);
+    using header_type = binomial_snapshot_header;
+    const char* magic = header_type::expected_magic;
+    header_type header{
+        {magic[0], magic[1], magic[2], magic[3]},
+        header_type::current_version,
+        sizeof(T),
+        uint32_t(degrees.size()),
+        _size
+    };
+    degrees.resize(header.keys_offset(alignof(T)) - sizeof(header));
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(degrees.data()), degrees.size());
+    for(uint64_t mask = occupied; mask; mask &= mask - 1)
+        save_tree(trees[lowest_degree(mask)], out);
+    for(const node* tree = pending; tree; tree = tree->sibling) save_tree(tree, out);
+}
+
+/**
+ *  @brief      Replaces the contents of the heap with a snapshot written by save(). Every node is
+ *              placed in a single block and linked by its preorder position, so the shape is
+ *              restored in one linear pass without comparing keys, apart from picking the minimum
+ *              among the roots. The comparison functor, merge mode and allocator are kept. Nodes
+ *              are read into a pool of their own that replaces the heap's only once every key has
+ *              arrived, so if the snapshot is malformed or cut short, std::runtime_error is thrown,
+ *              and if the block cannot be allocated, std::bad_alloc is thrown; in every case the
+ *              heap is left unchanged. O(n) time.
+ *  @param[in]  in the stream the snapshot is to be read from
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::load(std::istream& in) {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshots need trivially copyable keys");
+    binomial_snapshot_header header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.valid(sizeof(T)))
+        throw std::runtime_error("Invalid heap snapshot header");
+    std::vector<unsigned char> degrees(header.keys_offset(alignof(T)) - sizeof(header));
+    if(!in.read(reinterpret_cast<char*>(degrees.data()), degrees.size()))
+        throw std::runtime_error("Invalid heap snapshot header");
+    degrees.resize(header.tree_count);
+    uint64_t total = 0;
+    for(unsigned char degree : degrees) {
+        if(degree >= max_degree - 1 || total + (uint64_t(1) << degree) < total)
+            throw std::runtime_error("Invalid heap snapshot header");
+        total += uint64_t(1) << degree;
+    }
+    if(total != header.size || header.size >= SIZE_MAX / sizeof(node))
+        throw std::runtime_error("Invalid heap snapshot header");
+    if(!header.size) {
+        delete_trees();
+        return;
+    }
+    node_pool loaded(pool.allocator());
+    node* block = loaded.allocate_block(header.size);
+    constexpr size_t chunk_keys = sizeof(T) < 4096 ? 4096 / sizeof(T) : 1;
+    alignas(T) unsigned char chunk[chunk_keys * sizeof(T)];
+    for(size_t built = 0; built < header.size;) {
+        size_t count = std::min<size_t>(chunk_keys, header.size - built);
+        if(!in.read(reinterpret_cast<char*>(chunk), count * sizeof(T)))
+            throw std::runtime_error("Truncated heap snapshot");
+        const T* keys = reinterpret_cast<const T*>(chunk);
+        for(size_t i = 0; i < count; ++i, ++built) new(block + built) node(keys[i]);
+    }
+    delete_trees();
+    pool = std::move(loaded);
+    _size = header.size;
+    size_t index = 0;
+    for(unsigned char degree : degrees) {
+        node* tree = link_tree(block, index, degree);
+        if(!_min || compare(tree->key, _min->key)) _min = tree;
+        add_root(tree);
+    }
+}
+
+/**
+ *  @brief      Gets the handle of an element, issuing one if the element has none yet. Unlike an
+ *              iterator, a handle can be checked for validity after its element leaves the heap
+ *              and stays valid across merge(). O(1) am. time.
+ *  @param[in]  it an iterator containing the element
+ *  @return     the handle of the element
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::handle binomial_heap<T, Comp, Allocator>::get_handle(
+    const typename binomial_heap<T, Comp, Allocator>::iterator& it
+) {
+    node* target = it.data;
+    if(target->handle_slot == no_handle) {
+        if(!handles) handles = std::allocate_shared<handle_table>(get_allocator(), get_allocator());
+        target->handle_slot = handles->acquire(target);
+        ++live_handles;
+    }
+    return handle(target->handle_slot, handles->entries[target->handle_slot].generation);
+}
+
+/**
+ *  @brief      Checks whether a handle still refers to an element. O(1) time.
+ *  @param[in]  h the handle to be checked
+ *  @return     true if the element the handle was issued for is still in a heap using this
+ *              heap's handle table. Otherwise, false
+ */
+template<typename T, typename Comp, typename Allocator>
+bool binomial_heap<T, Comp, Allocator>::contains(
+    const typename binomial_heap<T, Comp, Allocator>::handle& h
+) const {
+    return handles && h.index < handles->entries.size() &&
+           handles->entries[h.index].generation == h.generation;
+}
+
+/**
+ *  @brief      Gets an iterator to the element a handle refers to. O(1) time.
+ *  @param[in]  h the handle of the element
+ *  @return     an iterator containing the element
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::iterator binomial_heap<T, Comp, Allocator>::lookup(
+    const typename binomial_heap<T, Comp, Allocator>::handle& h
+) const {
+    if(!contains(h)) throw std::out_of_range("Stale handle");
+    return iterator(handles->entries[h.index].target);
+}
+
+/**
+ *  @brief      Decreases the key of the element a handle refers to. O(log n) time.
+ *  @param[in]  h the handle of the element
+ *  @param[in]  new_key the value the key is to be decreased to
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::decrease_key(
+    const typename binomial_heap<T, Comp, Allocator>::handle& h,
+    T new_key
+) { decrease_key(lookup(h), std::move(new_key)); }
+
+/**
+ *  @brief      Removes the element a handle refers to. O(log n) time.
+ *  @param[in]  h the handle of the element
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::remove(
+    const typename binomial_heap<T, Comp, Allocator>::handle& h
+) {
+    remove(lookup(h));
+}
+
+/**
+ *  @brief          Makes this heap issue handles from the same table as other, so that handles
+ *                  from either heap stay valid when one is merged into the other. Handles are not
+ *                  synchronized, so heaps sharing a table must be used from a single thread.
+ *  @param[in, out] other the heap whose handle table is to be shared
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::share_handles(binomial_heap<T, Comp, Allocator>& other) {
+    if(live_handles) throw std::logic_error("Heap already has live handles");
+    if(!other.handles) {
+        Allocator alloc = other.get_allocator();
+        other.handles = std::allocate_shared<handle_table>(alloc, alloc);
+    }
+    handles = other.handles;
+}
+
+/**
+ *  @brief      Index of the lowest occupied degree in a root bitmask
+ *  @param[in]  mask a nonzero bitmask of occupied degrees
+ *  @return     the number of trailing zero bits in mask
+ */
+template<typename T, typename Comp, typename Allocator>
+unsigned binomial_heap<T, Comp, Allocator>::lowest_degree(
+    uint64_t mask
+) { return lowest_set_bit(mask); }
+
+/**
+ *  @brief      Constructs a node in storage taken from the pool
+ *  @param[in]  ...args parameter list for the constructor for node
+ *  @return     the newly constructed node
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class...Args>
+typename binomial_heap<T, Comp, Allocator>::node*
+binomial_heap<T, Comp, Allocator>::create_node(Args&&...args) {
+    void* storage = pool.allocate();
+    try { return new(storage) node(std::forward<Args>(args)...); }
+    catch(...) {
+        pool.deallocate(static_cast<node*>(storage));
+        throw;
+    }
+}
+
+/**
+ *  @brief      Destroys a single node and recycles its storage. Its children are left untouched.
+ *  @param[in]  target the node to be destroyed
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::destroy_node(
+    typename binomial_heap<T, Comp, Allocator>::node* target
+) {
+    release_handle(target);
+    target->~node();
+    pool.deallocate(target);
+}
+
+/**
+ *  @brief      Destroys every node of a tree and recycles their storage
+ *  @param[in]  root the root of the tree to be destroyed
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::destroy_tree(
+    typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    for(node* child = root->child; child;) {
+        node* next = child->sibling;
+        destroy_tree(child);
+        child = next;
+    }
+    destroy_node(root);
+}
+
+/**
+ *  @brief      Deep copies a tree into nodes taken from this heap's pool
+ *  @param[in]  root the root of the tree to be copied
+ *  @return     the root of the copy, with no parent or siblings
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node* binomial_heap<T, Comp, Allocator>::clone_tree(
+    const typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    node* copy = create_node(root->key);
+    copy->degree = root->degree;
+    node** link = &copy->child;
+    node* previous = copy;
+    for(const node* child = root->child; child; child = child->sibling) {
+        *link = clone_tree(child);
+        (*link)->back = previous;
+        previous = *link;
+        link = &previous->sibling;
+    }
+    return copy;
+}
+
+/**
+ *  @brief      Moves the keys of a tree of another heap into a matching tree of nodes from this
+ *              heap's pool. Handles follow their keys into the new nodes.
+ *  @param[in]  root the root of the tree whose keys are to be moved
+ *  @return     the root of the new tree
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node*
+binomial_heap<T, Comp, Allocator>::transplant_tree(
+    typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    node* moved = create_node(std::move(root->key));
+    moved->degree = root->degree;
+    if(root->handle_slot != no_handle) {
+        moved->handle_slot = root->handle_slot;
+        handles->entries[moved->handle_slot].target = moved;
+        root->handle_slot = no_handle;
+    }
+    node** link = &moved->child;
+    node* previous = moved;
+    for(node* child = root->child; child; child = child->sibling) {
+        *link = transplant_tree(child);
+        (*link)->back = previous;
+        previous = *link;
+        link = &previous->sibling;
+    }
+    return moved;
+}
+
+/**
+ *  @brief      Calls a visitor on every key of a tree, in preorder
+ *  @param[in]  root the root of the tree to be visited
+ *  @param[in]  visit the function to be called with each key
+ */
+template<typename T, typename Comp, typename Allocator>
+template<class Visitor>
+void binomial_heap<T, Comp, Allocator>::visit_tree(
+    const typename binomial_heap<T, Comp, Allocator>::node* root,
+    Visitor& visit
+) {
+    visit(root->key);
+    for(const node* child = root->child; child; child = child->sibling) visit_tree(child, visit);
+}
+
+/**
+ *  @brief      Writes the keys of a tree in preorder, children in the order they are linked
+ *  @param[in]  root the root of the tree to be written
+ *  @param[in]  out the stream the keys are to be written to
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::save_tree(
+    const typename binomial_heap<T, Comp, Allocator>::node* root,
+    std::ostream& out
+) const {
+    out.write(reinterpret_cast<const char*>(&root->key), sizeof(T));
+    for(const node* child = root->child; child; child = child->sibling) save_tree(child, out);
+}
+
+/**
+ *  @brief          Links the nodes of a preorder block into a binomial tree. The first child of a
+ *                  node of degree d sits right after it, and each later child follows the
+ *                  2^k nodes of its predecessor of degree k.
+ *  @param[in]      block the nodes in preorder
+ *  @param[in, out] index the position of the root in block, advanced past the tree
+ *  @param[in]      degree the degree of the tree
+ *  @return         the root of the tree
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node* binomial_heap<T, Comp, Allocator>::link_tree(
+    typename binomial_heap<T, Comp, Allocator>::node* block,
+    size_t& index,
+    unsigned degree
+) {
+    node* root = block + index++;
+    root->degree = degree;
+    node** link = &root->child;
+    node* previous = root;
+    for(unsigned child_degree = degree; child_degree--;) {
+        *link = link_tree(block, index, child_degree);
+        (*link)->back = previous;
+        previous = *link;
+        link = &previous->sibling;
+    }
+    return root;
+}
+
+/**
+ *  @brief      Deep copies every key of rhs into this empty heap, keeping the shape of its trees.
+ *              Trivially copyable keys are copied into a single block, one tree after another in
+ *              preorder; each tree can then be cloned independently, so trees are handed out to
+ *              up to threads tasks when rhs is large. Other keys are copied node by node.
+ *  @param[in]  rhs the binomial_heap to be copied
+ *  @param[in]  threads the maximum number of threads to clone with, defaults to 1
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::copy_from(
+    const binomial_heap<T, Comp, Allocator>& rhs,
+    size_t threads
+) {
+    compare = rhs.compare;
+    lazy = rhs.lazy;
+    if constexpr(std::is_trivially_copyable<T>::value) {
+        constexpr size_t min_parallel = size_t(1) << 16;
+        if(!rhs._size) return;
+        std::vector<const node*> sources;
+        for(uint64_t mask = rhs.occupied; mask; mask &= mask - 1)
+            sources.push_back(rhs.trees[lowest_degree(mask)]);
+        for(const node* tree = rhs.pending; tree; tree = tree->sibling) sources.push_back(tree);
+        node* block = pool.allocate_block(rhs._size);
+        std::vector<node*> copies(sources.size());
+        std::vector<size_t> offsets(sources.size());
+        for(size_t i = 1; i < sources.size(); ++i)
+            offsets[i] = offsets[i - 1] + (size_t(1) << sources[i - 1]->degree);
+        if(threads > 1 && rhs._size >= min_parallel) {
+            std::vector<std::future<void>> tasks;
+            for(size_t first = 0; first < std::min(threads, sources.size()); ++first) {
+                tasks.push_back(std::async(std::launch::async, [&, first] {
+                    for(size_t i = first; i < sources.size(); i += threads)
+                        copies[i] = flat_clone_tree(sources[i], block + offsets[i]);
+                }));
+            }
+            for(std::future<void>& task: tasks) task.get();
+        } else {
+            for(size_t i = 0; i < sources.size(); ++i)
+                copies[i] = flat_clone_tree(sources[i], block + offsets[i]);
+        }
+        for(node* copy : copies) add_tree(copy);
+        _size = rhs._size;
+        set_min();
+        return;
+    }
+    _size = rhs._size;
+    occupied = rhs.occupied;
+    for(uint64_t mask = occupied; mask; mask &= mask - 1) {
+        unsigned degree = lowest_degree(mask);
+        trees[degree] = clone_tree(rhs.trees[degree]);
+        root_keys.store(degree, trees[degree]->key);
+    }
+    for(const node* tree = rhs.pending; tree; tree = tree->sibling) add_tree(clone_tree(tree));
+    set_min();
+}
+
+/**
+ *  @brief      Copies a tree of trivially copyable keys into a block in preorder, without
+ *              recursion. Each node is copied whole with memcpy and its links are then pointed at
+ *              the copies of its relatives.
+ *  @param[in]  root the root of the tree to be copied
+ *  @param[in]  block the storage for the 2^degree nodes of the copy
+ *  @return     the root of the copy, which is the first node of block
+ */
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::node*
+binomial_heap<T, Comp, Allocator>::flat_clone_tree(
+    const typename binomial_heap<T, Comp, Allocator>::node* root,
+    typename binomial_heap<T, Comp, Allocator>::node* block
+) {
+    struct frame {
+        const node* source;
+        node* parent;
+        node* previous;
+    };
+    auto copy_node = [](const node* source, node* target) {
+        std::memcpy(static_cast<void*>(target), source, sizeof(node));
+        target->child = target->sibling = target->back = nullptr;
+        target->handle_slot = no_handle;
+        return target;
+    };
+    node* next = block;
+    node* copy = copy_node(root, next++);
+    frame stack[max_degree];
+    size_t depth = 0;
+    if(root->child) stack[depth++] = frame{root->child, copy, copy};
+    while(depth) {
+        frame& top = stack[depth - 1];
+        const node* source = top.source;
+        if(!source) { --depth; continue; }
+        top.source = source->sibling;
+        node* child = copy_node(source, next++);
+        if(top.previous == top.parent) top.parent->child = child;
+        else top.previous->sibling = child;
+        child->back = top.previous;
+        top.previous = child;
+        if(source->child) stack[depth++] = frame{source->child, child, child};
+    }
+    return copy;
+}
+
+/**
+ *  @brief          Moves every element of rhs into this empty heap, leaving rhs empty. The nodes
+ *                  and pool of rhs are taken over when both allocators compare equal; otherwise
+ *                  the keys are moved into new nodes as if by merge().
+ *  @param[in, out] rhs the binomial_heap to be moved
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::move_from(binomial_heap<T, Comp, Allocator>& rhs) {
+    compare = std::move(rhs.compare);
+    lazy = rhs.lazy;
+    if(get_allocator() != rhs.get_allocator()) {
+        splice_roots(rhs);
+        if(!lazy) consolidate();
+        return;
+    }
+    pool = std::move(rhs.pool);
+    std::copy(rhs.trees, rhs.trees + max_degree, trees);
+    occupied = rhs.occupied;
+    root_keys = rhs.root_keys;
+    pending = rhs.pending;
+    pending_tail = rhs.pending_tail;
+    handles = std::move(rhs.handles);
+    live_handles = rhs.live_handles;
+    _min = rhs._min;
+    _size = rhs._size;
+    rhs.live_handles = 0;
+    rhs.occupied = 0;
+    rhs.pending = rhs.pending_tail = nullptr;
+    rhs._min = nullptr;
+    rhs._size = 0;
+}
+
+/**
+ *  @brief      Invalidates the handle of a node that is about to be destroyed, if it has one
+ *  @param[in]  target the node whose handle is to be released
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::release_handle(
+    typename binomial_heap<T, Comp, Allocator>::node* target
+) {
+    if(target->handle_slot == no_handle) return;
+    handles->release(target->handle_slot);
+    target->handle_slot = no_handle;
+    --live_handles;
 }
 
 /**
- *  @brief  Empties the heap, destroying all elements. Requires linear time.
+ *  @brief  Empties the heap, destroying all elements and returning the pool's memory. Nodes are
+ *          destroyed slab by slab in allocation order rather than tree by tree. Requires linear
+ *          time, or time linear in the number of slabs if T is trivially destructible and no
+ *          element has a live handle.
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::delete_trees() {
-    for(node* tree: trees) delete tree;
-    trees.clear();
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::delete_trees() {
+    if(!std::is_trivially_destructible<T>::value || live_handles) {
+        pool.drain([this](node* target) {
+            release_handle(target);
+            target->~node();
+        });
+    }
+    pool.release();
+    occupied = 0;
+    pending = pending_tail = nullptr;
+    _min = nullptr;
     _size = 0;
 }
 
 /**
  *  @brief  Finds the min value of all of the roots. Requires logarithmic time.
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::set_min() {
-    if(trees.empty()) { _min = nullptr; return; }
-    _min = trees.front();
-    for(node* tree: trees) if(compare(tree->key, _min->key)) _min = tree;
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::set_min() {
+    if constexpr(root_key_mirror<T, Comp>::enabled) {
+        _min = occupied ? trees[root_keys.best(occupied)] : nullptr;
+        return;
+    }
+    _min = nullptr;
+    for(uint64_t mask = occupied; mask; mask &= mask - 1) {
+        node* tree = trees[lowest_degree(mask)];
+        if(!_min || compare(tree->key, _min->key)) _min = tree;
+    }
+}
+
+/**
+ *  @brief      Adds a new root to the heap: straight into the root array in eager mode, or onto
+ *              the pending list without any merging in lazy mode.
+ *  @param[in]  root the root to be added, with no parent or siblings
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::add_root(
+    typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    if(!lazy) { add_tree(root); return; }
+    add_pending(root);
+}
+
+/**
+ *  @brief      Appends a root to the pending list without any merging
+ *  @param[in]  root the root to be appended, with no parent or siblings
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::add_pending(
+    typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    if(pending_tail) pending_tail->sibling = root;
+    else pending = root;
+    pending_tail = root;
 }
 
 /**
- *  @brief  Zips up the tree list, merging together duplicate degree trees.
+ *  @brief          Moves every root of rhs onto this heap's pending list and takes over its pool
+ *                  and handles, leaving rhs empty. O(log n) time, or O(1) when rhs is lazy.
+ *  @param[in, out] rhs the heap to be emptied into this heap
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::zip() {
-    for(auto it = trees.begin(); it != trees.end() && std::next(it, 1) != trees.end();) {
-        auto next = std::next(it, 1);
-        if((*it)->children.size() > (*next)->children.size()) std::iter_swap(it, next);
-        if((*it)->children.size() == (*next)->children.size()) {
-            *it = (*it)->promote(*next, compare);
-            trees.erase(next);
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::splice_roots(binomial_heap<T, Comp, Allocator>& rhs) {
+    if(this == &rhs || !rhs._min) return;
+    if(rhs.live_handles && handles != rhs.handles) {
+        if(live_handles) throw std::invalid_argument("Heaps use different handle tables");
+        handles = rhs.handles;
+    }
+    live_handles += rhs.live_handles;
+    rhs.live_handles = 0;
+    _size += rhs._size;
+    if(get_allocator() != rhs.get_allocator()) {
+        for(uint64_t mask = rhs.occupied; mask; mask &= mask - 1) {
+            node* tree = rhs.trees[lowest_degree(mask)];
+            node* moved = transplant_tree(tree);
+            if(tree == rhs._min) rhs._min = moved;
+            add_pending(moved);
+        }
+        for(node* tree = rhs.pending; tree; tree = tree->sibling) {
+            node* moved = transplant_tree(tree);
+            if(tree == rhs._min) rhs._min = moved;
+            add_pending(moved);
         }
-        else it = next;
+        if(!_min || compare(rhs._min->key, _min->key)) _min = rhs._min;
+        rhs._min = nullptr;
+        rhs._size = 0;
+        rhs.delete_trees();
+        return;
     }
+    if(!_min || compare(rhs._min->key, _min->key)) _min = rhs._min;
+    for(uint64_t mask = rhs.occupied; mask; mask &= mask - 1)
+        add_pending(rhs.trees[lowest_degree(mask)]);
+    if(rhs.pending) {
+        if(pending_tail) pending_tail->sibling = rhs.pending;
+        else pending = rhs.pending;
+        pending_tail = rhs.pending_tail;
+    }
+    pool.splice(rhs.pool);
+    rhs.pending = rhs.pending_tail = nullptr;
+    rhs.occupied = 0;
+    rhs._min = nullptr;
+    rhs._size = 0;
 }
 
 /**
- *  @brief  Zips up the tree list until it reaches any two distinct degrees, at which point merging
- *          stops. Meant for insertion.
+ *  @brief      Adds a freshly constructed node to the heap as a new root. O(1) am. time
+ *  @param[in]  new_tree the node to be inserted
+ *  @return     an iterator containing new_tree
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::fast_zip() {
-    for(auto it = trees.begin(); it != trees.end() && (std::next(it, 1)) != trees.end();) {
-        auto next = std::next(it, 1);
-        if((*it)->children.size() == (*next)->children.size()) {
-            *it = (*it)->promote(*next, compare);
-            trees.erase(next);
-        }
-        else return;
+template<typename T, typename Comp, typename Allocator>
+typename binomial_heap<T, Comp, Allocator>::iterator binomial_heap<T, Comp, Allocator>::insert_node(
+    typename binomial_heap<T, Comp, Allocator>::node* new_tree
+) {
+    ++_size;
+    if(!_min || compare(new_tree->key, _min->key)) _min = new_tree;
+    add_root(new_tree);
+    return iterator(new_tree);
+}
+
+/**
+ *  @brief  Moves every pending root into the root array in a single degree-bucketed pass. The
+ *          min stays a root, so _min remains valid. Linear in the number of pending roots.
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::consolidate() {
+    for(node* tree = pending; tree;) {
+        node* next = tree->sibling;
+        tree->sibling = nullptr;
+        add_tree(tree);
+        tree = next;
+    }
+    pending = pending_tail = nullptr;
+}
+
+/**
+ *  @brief      Removes a root from the heap, destroying it and adding each of its subtrees back
+ *              to the root array. O(log n) time.
+ *  @param[in]  root the root to be removed
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::remove_root(
+    typename binomial_heap<T, Comp, Allocator>::node* root
+) {
+    occupied &= ~(uint64_t(1) << root->degree);
+    _min = nullptr;
+    for(node* child = root->child; child;) {
+        node* next = child->sibling;
+        child->sibling = nullptr;
+        child->back = nullptr;
+        add_tree(child);
+        child = next;
+    }
+    destroy_node(root);
+    set_min();
+    --_size;
+}
+
+/**
+ *  @brief      Exchanges the positions of a node and its parent in constant time. The node takes
+ *              over its parent's place, siblings and children, and the parent takes over the
+ *              node's old place among them along with the node's own children. Keys never move.
+ *  @param[in]  target the node to be moved up one level
+ *  @param[in]  parent the current parent of target
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::swap_with_parent(
+    typename binomial_heap<T, Comp, Allocator>::node* target,
+    typename binomial_heap<T, Comp, Allocator>::node* parent
+) {
+    node* parent_back = parent->back;
+    node* parent_sibling = parent->sibling;
+    node* target_children = target->child;
+    if(parent->child == target) {
+        target->child = parent;
+        parent->back = target;
+    } else {
+        target->child = parent->child;
+        target->child->back = target;
+        target->back->sibling = parent;
+        parent->back = target->back;
     }
+    parent->sibling = target->sibling;
+    if(parent->sibling) parent->sibling->back = parent;
+    parent->child = target_children;
+    if(target_children) target_children->back = parent;
+    target->back = parent_back;
+    target->sibling = parent_sibling;
+    if(parent_sibling) parent_sibling->back = target;
+    if(!parent_back) {
+        trees[parent->degree] = target;
+        root_keys.store(parent->degree, target->key);
+    }
+    else if(parent_back->child == parent) parent_back->child = target;
+    else parent_back->sibling = target;
+    std::swap(target->degree, parent->degree);
+}
+
+/**
+ *  @brief      Adds a tree to the root array like a carry in a binary counter, merging it with
+ *              each equal-degree root it meets. The current min is always kept as a root.
+ *  @param[in]  tree the root of the tree to be added
+ */
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::add_tree(
+    typename binomial_heap<T, Comp, Allocator>::node* tree
+) {
+    add_tree(trees, occupied, tree);
 }
 
 /**
- *  @brief      Merges this tree list with rhs, zipping up the list afterwards.
- *  @param[in]  rhs the list with which this list is to be merged.
+ *  @brief          Adds a tree to any degree-indexed forest like a carry in a binary counter
+ *  @param[in, out] forest the roots of the forest, indexed by degree
+ *  @param[in, out] mask the occupied degrees of forest
+ *  @param[in]      tree the root of the tree to be added
  */
-template<typename T, typename Comp>
-void binomial_heap<T, Comp>::merge_lists(
-    std::list<typename binomial_heap<T, Comp>::node*>&& rhs
+template<typename T, typename Comp, typename Allocator>
+void binomial_heap<T, Comp, Allocator>::add_tree(
+    typename binomial_heap<T, Comp, Allocator>::node** forest,
+    uint64_t& mask,
+    typename binomial_heap<T, Comp, Allocator>::node* tree
 ) {
-    trees.merge(rhs, [] (node* a, node* b) { return a->children.size() < b->children.size(); });
-    zip();
+    size_t degree = tree->degree;
+    for(; mask & (uint64_t(1) << degree); ++degree) {
+        mask &= ~(uint64_t(1) << degree);
+        node* root = forest[degree];
+        tree = tree == _min ? tree->promote(root, compare) : root->promote(tree, compare);
+    }
+    forest[degree] = tree;
+    mask |= uint64_t(1) << degree;
+    if(forest == trees) root_keys.store(degree, tree->key);
+}
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+namespace pmr {
+/**
+ *  @brief  A binomial_heap that draws its nodes and handles from a std::pmr::memory_resource
+ */
+template<typename T, typename Comp = std::less<T>>
+using binomial_heap = ::binomial_heap<T, Comp, std::pmr::polymorphic_allocator<T>>;
 }
-#endif
\ No newline at end of file
+#endif
+#endif
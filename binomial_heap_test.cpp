@@ -8,10 +8,185 @@
 #include <iostream>
 #include <ctime>
 #include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <set>
 #include <algorithm>
+#include <memory>
 #include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "addressable_heap.h"
 #include "binomial_heap.h"
+#include "bounded_heap.h"
+#include "double_ended_heap.h"
+#include "keyed_heap.h"
 #include "heap_sort.h"
+#include "mapped_heap.h"
+#include "mpsc_heap.h"
+#include "multi_queue.h"
+#include "persistent_heap.h"
+#include "static_heap.h"
+
+static int failures = 0;
+static size_t allocated_bytes = 0;
+static const size_t allocation_limit = size_t(1) << 32;
+
+/**
+ *  @brief      Prints the outcome of a behaviour check and counts it if it failed
+ *  @param[in]  what a description of the behaviour being checked
+ *  @param[in]  passed whether the behaviour was observed
+ */
+void check(const char* what, bool passed) {
+    std::cout << (passed ? "[pass] " : "[FAIL] ") << what << std::endl;
+    if(!passed) ++failures;
+}
+
+/**
+ *  @brief  An allocator that keeps allocated_bytes up to date across all of its rebinds and
+ *          refuses any single request larger than allocation_limit
+ */
+template<typename T>
+struct counting_allocator {
+    using value_type = T;
+    counting_allocator() = default;
+    template<typename U> counting_allocator(const counting_allocator<U>&) {}
+    T* allocate(size_t n) {
+        if(n > allocation_limit / sizeof(T)) throw std::bad_alloc();
+        allocated_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        allocated_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+    template<typename U> bool operator==(const counting_allocator<U>&) const { return true; }
+    template<typename U> bool operator!=(const counting_allocator<U>&) const { return false; }
+};
+
+/**
+ *  @brief  A key whose copies start throwing once a shared budget of copies runs out
+ */
+struct flaky_key {
+    static inline int copies_left = 1 << 30;
+    explicit flaky_key(int value) : value(value) {}
+    flaky_key(const flaky_key& rhs) : value(rhs.value) {
+        if(!copies_left--) throw std::runtime_error("copy failed");
+    }
+    bool operator<(const flaky_key& rhs) const { return value < rhs.value; }
+    int value;
+};
+
+/**
+ *  @brief  Orders unique_ptrs by the integers they own
+ */
+struct pointee_less {
+    bool operator()(const std::unique_ptr<int>& lhs, const std::unique_ptr<int>& rhs) const {
+        return *lhs < *rhs;
+    }
+};
+
+/**
+ *  @brief      Pops every key out of a copy of a heap
+ *  @param[in]  heap the heap whose keys are wanted
+ *  @return     the keys of the heap in the order they were popped
+ */
+template<typename Heap>
+std::vector<int> popped_keys(Heap heap) {
+    std::vector<int> keys;
+    while(!heap.empty()) keys.push_back(heap.pop());
+    return keys;
+}
+
+/**
+ *  @brief      Loads a snapshot into a heap and reports whether the load was refused
+ *  @param[in]  heap the heap the snapshot is to be loaded into
+ *  @param[in]  snapshot the bytes of the snapshot
+ *  @return     true if load() threw. Otherwise, false
+ */
+template<typename Heap>
+bool load_throws(Heap& heap, const std::string& snapshot) {
+    std::istringstream in(snapshot);
+    try { heap.load(in); }
+    catch(const std::exception&) { return true; }
+    return false;
+}
+
+/**
+ *  @brief      Saves a heap to a file, maps it and interleaves insert(), extract() and for_each()
+ *              on the mapping against a std::multiset holding the same keys
+ *  @param[in]  source the heap to be saved
+ *  @return     true if the mapped heap agreed with the multiset throughout. Otherwise, false
+ */
+bool mapped_matches(const binomial_heap<int>& source) {
+    const char* path = "mapped_heap_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        source.save(out);
+    }
+    std::vector<int> keys = popped_keys(source);
+    std::multiset<int> reference(keys.begin(), keys.end());
+    bool matched = true;
+    {
+        mapped_binomial_heap<int> mapped(path);
+        matched = mapped.image_size() == reference.size();
+        for(int step = 0; matched && !reference.empty(); ++step) {
+            if(step % 3 == 0) {
+                int key = std::rand() % 2000;
+                mapped.insert(key);
+                reference.insert(key);
+            }
+            if(step % 5 == 0) {
+                std::vector<int> visited;
+                mapped.for_each([&](const int& key) { visited.push_back(key); });
+                std::sort(visited.begin(), visited.end());
+                matched = visited == std::vector<int>(reference.begin(), reference.end());
+            }
+            if(mapped.top() != *reference.begin() || mapped.extract() != *reference.begin())
+                matched = false;
+            reference.erase(reference.begin());
+        }
+        matched = matched && mapped.empty();
+    }
+    std::remove(path);
+    return matched;
+}
+
+/**
+ *  @brief  Inserts, decreases, removes and pops keys in a static_binomial_heap, so that the whole
+ *          sequence can be evaluated at compile time
+ *  @return the keys left after the updates, in the order they were popped
+ */
+constexpr std::array<int, 8> static_heap_order() {
+    static_binomial_heap<int, 10> heap;
+    int keys[10] = {50, 20, 80, 10, 70, 30, 60, 40, 90, 100};
+    size_t slots[10] = {};
+    for(int i = 0; i < 10; ++i) slots[i] = heap.insert(keys[i]);
+    heap.decrease_key(slots[2], 5);
+    heap.remove(slots[3]);
+    heap.remove(slots[9]);
+    std::array<int, 8> order{};
+    for(int& key: order) key = heap.pop();
+    return order;
+}
+
+/**
+ *  @brief  Compares static_heap_order() with the expected order element by element, since
+ *          std::array comparisons are only constexpr from C++20 on
+ *  @return true if every key was popped where expected. Otherwise, false
+ */
+constexpr bool static_heap_order_matches() {
+    constexpr int expected[8] = {5, 20, 30, 40, 50, 60, 70, 90};
+    std::array<int, 8> order = static_heap_order();
+    for(size_t i = 0; i < order.size(); ++i)
+        if(order[i] != expected[i]) return false;
+    return true;
+}
+static_assert(
+    static_heap_order_matches(),
+    "static_binomial_heap must work in constant expressions"
+);
 
 int main() {
     std::srand(std::time(0));
@@ -25,4 +200,461 @@ int main() {
     std::cout << std::endl;
     std::cout << "Sorted: ";
     for(int n: unsorted) std::cout << n << " ";
-}
\ No newline at end of file
+    std::cout << std::endl;
+
+    binomial_heap<int> heap;
+    std::vector<binomial_heap<int>::iterator> iters;
+    for(int n = 1; n <= 10; ++n) iters.push_back(heap.iter_insert(n * 10));
+    heap.decrease_key(iters[7], 5);
+    heap.remove(iters[0]);
+    heap.remove(iters[4]);
+    std::vector<int> updated_order;
+    while(!heap.empty()) updated_order.push_back(heap.extract());
+    check("decrease_key(80 -> 5), remove(10), remove(50) leave 5 20 30 40 60 70 90 100",
+        updated_order == std::vector<int>{5, 20, 30, 40, 60, 70, 90, 100});
+
+    binomial_heap<int, std::less<int>, counting_allocator<int>> churned;
+    int batch[3] = {3, 1, 2};
+    churned.multi_insert(batch, batch + 3);
+    churned.iter_multi_insert(batch, batch + 3);
+    while(!churned.empty()) churned.pop();
+    size_t settled = allocated_bytes;
+    for(int i = 0; i < 100000; ++i) {
+        churned.multi_insert(batch, batch + 1);
+        churned.iter_multi_insert(batch, batch + 3);
+        while(!churned.empty()) churned.pop();
+    }
+    check(
+        "multi_insert/pop churn reuses freed nodes",
+        allocated_bytes == settled
+    );
+
+    constexpr int producers = 4, per_producer = 20000;
+    mpsc_heap<int> inbox;
+    std::vector<std::thread> producing;
+    for(int p = 0; p < producers; ++p) {
+        producing.emplace_back([&inbox, p] {
+            for(int i = 0; i < per_producer; ++i) inbox.push(i * producers + p);
+        });
+    }
+    std::vector<int> consumed;
+    while(consumed.size() < size_t(producers * per_producer)) {
+        if(std::optional<int> key = inbox.try_pop()) consumed.push_back(*key);
+    }
+    for(std::thread& producer: producing) producer.join();
+    std::sort(consumed.begin(), consumed.end());
+    std::vector<int> expected(producers * per_producer);
+    std::iota(expected.begin(), expected.end(), 0);
+    check(
+        "mpsc_heap delivers every pushed key exactly once",
+        consumed == expected && inbox.empty()
+    );
+
+    constexpr int workers = 4, per_worker = 20000;
+    multi_queue<int> relaxed(workers);
+    relaxed.sample_rank_error(7);
+    std::vector<std::vector<int>> popped(workers);
+    std::vector<std::thread> working;
+    for(int w = 0; w < workers; ++w) {
+        working.emplace_back([&relaxed, &popped, w] {
+            for(int i = 0; i < per_worker; ++i) {
+                relaxed.push(i * workers + w);
+                if(i % 2)
+                    if(std::optional<int> key = relaxed.try_pop()) popped[w].push_back(*key);
+            }
+        });
+    }
+    for(std::thread& worker: working) worker.join();
+    std::vector<int> drained;
+    for(const std::vector<int>& keys: popped)
+        drained.insert(drained.end(), keys.begin(), keys.end());
+    while(std::optional<int> key = relaxed.try_pop()) drained.push_back(*key);
+    std::sort(drained.begin(), drained.end());
+    expected.resize(workers * per_worker);
+    std::iota(expected.begin(), expected.end(), 0);
+    multi_queue<int>::statistics relaxed_stats = relaxed.stats();
+    check(
+        "multi_queue pops every key exactly once while sampling rank error",
+        drained == expected && relaxed.empty() && relaxed_stats.rank_samples > 0 &&
+            relaxed_stats.pushes == relaxed_stats.pops
+    );
+
+    binomial_heap<int> saved;
+    for(int n = 0; n < 1000; ++n) saved.insert((n * 7919) % 1000);
+    for(int n = 0; n < 300; ++n) saved.pop();
+    std::ostringstream snapshot_out;
+    saved.save(snapshot_out);
+    std::string snapshot = snapshot_out.str();
+    binomial_heap<int> restored;
+    restored.insert(-1);
+    check("save/load round trip", !load_throws(restored, snapshot) &&
+        popped_keys(restored) == popped_keys(saved));
+    binomial_heap<int> untouched;
+    untouched.insert(42);
+    untouched.insert(7);
+    std::vector<int> untouched_keys = popped_keys(untouched);
+    check("load of a truncated snapshot throws and leaves the heap unchanged",
+        load_throws(untouched, snapshot.substr(0, snapshot.size() - sizeof(int))) &&
+        popped_keys(untouched) == untouched_keys);
+    std::string bad_magic = snapshot;
+    bad_magic[0] = 'X';
+    check("load of a snapshot with a bad header throws and leaves the heap unchanged",
+        load_throws(untouched, bad_magic) && popped_keys(untouched) == untouched_keys);
+    binomial_snapshot_header oversized{{'B', 'N', 'H', 'P'}, 1, sizeof(int), 1, uint64_t(1) << 50};
+    std::string oversized_snapshot(reinterpret_cast<const char*>(&oversized), sizeof(oversized));
+    oversized_snapshot += char(50);
+    oversized_snapshot.resize(oversized.keys_offset(alignof(int)));
+    binomial_heap<int, std::less<int>, counting_allocator<int>> capped;
+    capped.insert(42);
+    capped.insert(7);
+    check("load of a snapshot too large to allocate leaves the heap unchanged",
+        load_throws(capped, oversized_snapshot) && popped_keys(capped) == untouched_keys);
+
+    check("mapped heap over an eager snapshot matches a reference", mapped_matches(saved));
+    binomial_heap<int> lazy(std::less<int>(), binomial_heap<int>::merge_mode::lazy);
+    binomial_heap<int> lazy_rhs(std::less<int>(), binomial_heap<int>::merge_mode::lazy);
+    for(int n = 0; n < 200; ++n) lazy.insert(std::rand() % 2000);
+    for(int n = 0; n < 50; ++n) lazy.pop();
+    for(int n = 0; n < 40; ++n) lazy.insert(std::rand() % 2000);
+    for(int n = 0; n < 70; ++n) lazy_rhs.insert(std::rand() % 2000);
+    lazy_rhs.pop();
+    lazy.merge(lazy_rhs);
+    check("mapped heap over a lazy snapshot with repeated degrees matches a reference",
+        mapped_matches(lazy));
+
+    addressable_heap<int, int> addressed;
+    addressed.push_or_decrease(1, 50);
+    addressed.push_or_decrease(2, 30);
+    addressed.push_or_decrease(3, 40);
+    addressed.push_or_decrease(7, 10);
+    bool lowered = addressed.push_or_decrease(3, 20);
+    bool kept = !addressed.push_or_decrease(2, 35);
+    bool erased = addressed.erase(7) && !addressed.erase(7) && !addressed.contains(7);
+    std::vector<std::pair<int, int>> addressed_order;
+    while(!addressed.empty()) addressed_order.push_back(addressed.pop());
+    check("addressable_heap push_or_decrease/erase/pop order", lowered && kept && erased &&
+        addressed_order == std::vector<std::pair<int, int>>{{3, 20}, {2, 30}, {1, 50}});
+
+    bounded_heap<int> top_five(5);
+    std::vector<int> offered(100);
+    std::iota(offered.begin(), offered.end(), 1);
+    std::random_shuffle(offered.begin(), offered.end());
+    for(int n: offered) top_five.insert(n);
+    bool retained = top_five.size() == 5 && top_five.full() && top_five.worst() == 5 &&
+        !top_five.accepts(6) && !top_five.insert(6);
+    bool worst_first = top_five.pop_worst() == 5 && top_five.pop_worst() == 4 &&
+        top_five.insert(50) && top_five.worst() == 50;
+    std::vector<int> best_first;
+    while(!top_five.empty()) best_first.push_back(top_five.pop());
+    check("bounded_heap keeps the top k and pops the worst on request", retained && worst_first &&
+        best_first == std::vector<int>{1, 2, 3, 50});
+
+    double_ended_binomial_heap<int> both_ends;
+    double_ended_binomial_heap<int> other_end;
+    std::multiset<int> both_reference;
+    for(int n = 0; n < 500; ++n) {
+        int key = std::rand() % 1000;
+        (n % 2 ? both_ends : other_end).insert(key);
+        both_reference.insert(key);
+    }
+    both_ends.merge(std::move(other_end));
+    bool ends_matched = both_ends.size() == both_reference.size();
+    for(int step = 0; ends_matched && !both_reference.empty(); ++step) {
+        if(step % 4 == 3) {
+            int key = std::rand() % 1000;
+            both_ends.insert(key);
+            both_reference.insert(key);
+        }
+        if(both_ends.min() != *both_reference.begin()) ends_matched = false;
+        if(both_ends.max() != *both_reference.rbegin()) ends_matched = false;
+        if(std::rand() % 2) {
+            ends_matched = ends_matched && both_ends.extract_min() == *both_reference.begin();
+            both_reference.erase(both_reference.begin());
+        } else {
+            ends_matched = ends_matched && both_ends.extract_max() == *both_reference.rbegin();
+            both_reference.erase(std::prev(both_reference.end()));
+        }
+    }
+    check("double_ended_binomial_heap interleaves extract_min and extract_max",
+        ends_matched && both_ends.empty());
+
+    keyed_binomial_heap<int, std::string> keyed, keyed_rhs;
+    for(int n: offered) (n % 3 ? keyed : keyed_rhs).insert(n, "payload " + std::to_string(n));
+    bool payloads_followed = true;
+    for(int n = 0; n < 10; ++n) {
+        payloads_followed = payloads_followed &&
+            keyed.top_value() == "payload " + std::to_string(keyed.top_key());
+        std::pair<int, std::string> popped = keyed.pop();
+        payloads_followed = payloads_followed &&
+            popped.second == "payload " + std::to_string(popped.first);
+        popped = keyed_rhs.pop();
+        payloads_followed = payloads_followed &&
+            popped.second == "payload " + std::to_string(popped.first);
+    }
+    keyed.merge(std::move(keyed_rhs));
+    std::vector<int> keyed_order;
+    while(!keyed.empty()) {
+        std::pair<int, std::string> popped = keyed.pop();
+        payloads_followed = payloads_followed &&
+            popped.second == "payload " + std::to_string(popped.first);
+        keyed_order.push_back(popped.first);
+    }
+    check("keyed_binomial_heap payloads follow their keys across pop() and merge()",
+        payloads_followed && keyed_order.size() == 80 &&
+        std::is_sorted(keyed_order.begin(), keyed_order.end()));
+
+    check("static_binomial_heap gives the same order at run time as at compile time",
+        static_heap_order_matches());
+
+    auto version_keys = [](persistent_binomial_heap<int> version) {
+        std::vector<int> keys;
+        for(; !version.empty(); version = version.pop()) keys.push_back(version.top());
+        return keys;
+    };
+    std::vector<persistent_binomial_heap<int>> versions(1);
+    std::vector<std::multiset<int>> version_contents(1);
+    for(int n = 0; n < 40; ++n) {
+        int key = std::rand() % 100;
+        versions.push_back(versions.back().insert(key));
+        version_contents.push_back(version_contents.back());
+        version_contents.back().insert(key);
+    }
+    for(int n = 0; n < 20; ++n) {
+        size_t from = std::rand() % versions.size();
+        if(versions[from].empty()) continue;
+        versions.push_back(versions[from].pop());
+        version_contents.push_back(version_contents[from]);
+        version_contents.back().erase(version_contents.back().begin());
+        size_t other = std::rand() % versions.size();
+        versions.push_back(versions.back().merge(versions[other]));
+        version_contents.push_back(version_contents.back());
+        const std::multiset<int>& merged = version_contents[other];
+        version_contents.back().insert(merged.begin(), merged.end());
+    }
+    bool versions_kept = true;
+    for(size_t i = 0; i < versions.size(); ++i) {
+        versions_kept = versions_kept && versions[i].size() == version_contents[i].size() &&
+            version_keys(versions[i]) ==
+            std::vector<int>(version_contents[i].begin(), version_contents[i].end());
+    }
+    check("persistent_binomial_heap versions are unchanged by later insert/pop/merge",
+        versions_kept);
+
+    keyed_binomial_heap<int, std::string> keyed_source;
+    keyed_source.insert(1, "a");
+    keyed_source.insert(3, "c");
+    keyed_source.insert(2, "b");
+    keyed_binomial_heap<int, std::string> keyed_copy = keyed_source, keyed_assigned;
+    keyed_assigned = keyed_copy;
+    bool copies_apart = keyed_copy.pop() == std::pair<int, std::string>(1, "a") &&
+        keyed_copy.top_value() == "b" && keyed_assigned.pop().second == "a" &&
+        keyed_assigned.pop().second == "b" && keyed_assigned.top_value() == "c";
+    for(const char* expected_value: {"a", "b", "c"})
+        copies_apart = copies_apart && keyed_source.pop().second == expected_value;
+    check("keyed_binomial_heap copies pop independently of their source", copies_apart);
+
+    addressable_heap<int, int> addressed_source;
+    addressable_heap<std::string, int> named_source;
+    for(int id = 1; id <= 5; ++id) {
+        addressed_source.push_or_decrease(id, id * 10);
+        named_source.push_or_decrease(std::to_string(id), id * 10);
+    }
+    addressable_heap<int, int> addressed_copy = addressed_source;
+    addressable_heap<std::string, int> named_copy;
+    named_copy = named_source;
+    addressed_copy.push_or_decrease(5, 1);
+    named_copy.push_or_decrease("5", 1);
+    addressed_source.erase(3);
+    named_source.erase("3");
+    check("addressable_heap copies are indexed independently of their source",
+        addressed_copy.top_id() == 5 && addressed_copy.contains(3) &&
+        addressed_source.top_id() == 1 && addressed_source.priority(5) == 50 &&
+        !addressed_source.contains(3) && named_copy.top_id() == "5" &&
+        named_copy.priority("3") == 30 && !named_source.contains("3") &&
+        named_source.priority("5") == 50);
+
+    using int_handle = binomial_heap<int>::handle;
+    binomial_heap<int> handled, unhandled;
+    int_handle h10 = handled.handle_insert(10);
+    int_handle h20 = handled.handle_insert(20);
+    int_handle h30 = handled.handle_insert(30);
+    bool looked_up = handled.contains(h10) && *handled.lookup(h20) == 20 && handled.pop() == 10;
+    int_handle h40 = handled.handle_insert(40);
+    bool stale = false;
+    try { handled.lookup(h10); }
+    catch(const std::out_of_range&) { stale = true; }
+    stale = stale && !handled.contains(h10) && handled.contains(h40) && h40 != h10 &&
+        !unhandled.contains(h20);
+    check("handles go stale when their element leaves, even if the slot is reused",
+        looked_up && stale);
+    unhandled.insert(25);
+    unhandled.merge(handled);
+    unhandled.decrease_key(h30, 1);
+    bool merged_handles = unhandled.contains(h20) && *unhandled.lookup(h40) == 40 &&
+        unhandled.pop() == 1 && !unhandled.contains(h30);
+    unhandled.remove(h20);
+    check("handles survive merge() and still work with decrease_key() and remove()",
+        merged_handles && !unhandled.contains(h20) && popped_keys(unhandled) ==
+        std::vector<int>{25, 40});
+    binomial_heap<int> own_table, other_table;
+    own_table.handle_insert(1);
+    int_handle other_handle = other_table.handle_insert(2);
+    bool refused = false;
+    try { own_table.merge(other_table); }
+    catch(const std::invalid_argument&) { refused = true; }
+    refused = refused && own_table.size() == 1 && other_table.contains(other_handle);
+    binomial_heap<int> sharing, shared;
+    sharing.share_handles(shared);
+    int_handle sharing_handle = sharing.handle_insert(3);
+    int_handle shared_handle = shared.handle_insert(4);
+    sharing.merge(shared);
+    check("merging heaps with separate handle tables throws unless they share one",
+        refused && sharing.contains(sharing_handle) && *sharing.lookup(shared_handle) == 4);
+
+    std::vector<int> parallel_sorted(200000), reference_sorted;
+    for(int& key: parallel_sorted) key = std::rand();
+    reference_sorted = parallel_sorted;
+    binom_heap_sort(binom_parallel_policy{4}, parallel_sorted.begin(), parallel_sorted.end());
+    std::sort(reference_sorted.begin(), reference_sorted.end());
+    bool parallel_matched = parallel_sorted == reference_sorted;
+    for(int& key: parallel_sorted) key = std::rand() % 1000;
+    reference_sorted = parallel_sorted;
+    binom_heap_sort(
+        binom_parallel_policy{3},
+        parallel_sorted.begin(),
+        parallel_sorted.end(),
+        std::greater<int>()
+    );
+    std::sort(reference_sorted.begin(), reference_sorted.end(), std::greater<int>());
+    check("parallel binom_heap_sort matches std::sort, with and without a custom comparator",
+        parallel_matched && parallel_sorted == reference_sorted);
+
+    binomial_heap<int> cloned_source;
+    binomial_heap<int> lazy_cloned_source(std::less<int>(), binomial_heap<int>::merge_mode::lazy);
+    for(int n = 0; n < 70001; ++n) {
+        cloned_source.insert(std::rand());
+        lazy_cloned_source.insert(std::rand());
+    }
+    cloned_source.pop();
+    bool clones_matched = true;
+    for(binomial_heap<int>* source: {&cloned_source, &lazy_cloned_source}) {
+        binomial_heap<int> cloned = source->clone(4);
+        clones_matched = clones_matched && cloned.size() == source->size();
+        while(clones_matched && !source->empty())
+            clones_matched = cloned.pop() == source->pop();
+        clones_matched = clones_matched && cloned.empty();
+    }
+    check("clone(threads) of more than 2^16 keys pops in lockstep with its source",
+        clones_matched);
+
+    std::vector<binomial_heap<int>> merged_parts;
+    std::vector<int> merged_reference;
+    for(int part = 0; part < 12; ++part) {
+        merged_parts.emplace_back(std::less<int>(), part % 2
+            ? binomial_heap<int>::merge_mode::lazy
+            : binomial_heap<int>::merge_mode::eager);
+        for(int n = 0; part != 5 && n < 100 + part * 37; ++n) {
+            merged_reference.push_back(std::rand() % 5000);
+            merged_parts.back().insert(merged_reference.back());
+        }
+    }
+    binomial_heap<int> merged_into;
+    merged_into.insert(-1);
+    int_handle merged_handle = merged_parts[3].handle_insert(2500);
+    merged_reference.push_back(-1);
+    merged_reference.push_back(2500);
+    std::sort(merged_reference.begin(), merged_reference.end());
+    merged_into.merge_all(merged_parts.begin(), merged_parts.end(), 4);
+    bool parts_emptied = std::all_of(merged_parts.begin(), merged_parts.end(),
+        [](const binomial_heap<int>& part) { return part.empty(); });
+    check("merge_all of mixed lazy/eager heaps, one empty, matches a sorted reference",
+        parts_emptied && *merged_into.lookup(merged_handle) == 2500 &&
+        popped_keys(merged_into) == merged_reference);
+    merged_parts.assign(12, binomial_heap<int>());
+    for(size_t part = 0; part < merged_parts.size(); ++part)
+        for(int n = 0; n < 50; ++n) merged_parts[part].insert(int(part) * 50 + n);
+    merged_into.clear();
+    merged_into.merge_all(merged_parts.begin(), merged_parts.end(), 4);
+    std::vector<int> merged_order(600);
+    std::iota(merged_order.begin(), merged_order.end(), 0);
+    check("merge_all without handles reduces in parallel to a sorted reference",
+        popped_keys(merged_into) == merged_order);
+
+    size_t before_cleared = allocated_bytes;
+    binomial_heap<int, std::less<int>, counting_allocator<int>> cleared;
+    for(int n = 0; n < 100000; ++n) cleared.insert(std::rand());
+    for(int n = 0; n < 1000; ++n) cleared.pop();
+    cleared.clear();
+    bool cleared_released = cleared.empty() && allocated_bytes == before_cleared;
+    for(int n = 10; n > 0; --n) cleared.insert(n);
+    std::vector<int> one_to_ten(10);
+    std::iota(one_to_ten.begin(), one_to_ten.end(), 1);
+    check("clear() on a large heap returns every slab and leaves the heap reusable",
+        cleared_released && popped_keys(cleared) == one_to_ten);
+    binomial_heap<int> cleared_handled;
+    std::vector<int_handle> cleared_handles;
+    for(int n = 0; n < 5000; ++n) cleared_handles.push_back(cleared_handled.handle_insert(n));
+    for(int n = 0; n < 2000; ++n) cleared_handled.pop();
+    cleared_handled.clear();
+    bool handles_dropped = std::none_of(cleared_handles.begin(), cleared_handles.end(),
+        [&](const int_handle& h) { return cleared_handled.contains(h); });
+    int_handle reissued = cleared_handled.handle_insert(7);
+    binomial_heap<std::string> cleared_strings;
+    for(int n = 0; n < 5000; ++n) cleared_strings.insert(std::string(40, char('a' + n % 26)));
+    for(int n = 0; n < 2000; ++n) cleared_strings.pop();
+    cleared_strings.clear();
+    cleared_strings.insert("reused");
+    check("clear() with live handles or non-trivial keys skips freed slots and stales handles",
+        handles_dropped && *cleared_handled.lookup(reissued) == 7 &&
+        cleared_strings.pop() == "reused" && cleared_strings.empty());
+
+    mpsc_heap<flaky_key> flaky_inbox;
+    for(int n = 10; n > 0; --n) flaky_inbox.emplace(n);
+    flaky_key::copies_left = 4;
+    bool drain_failed = false;
+    try { flaky_inbox.drain(); }
+    catch(const std::runtime_error&) { drain_failed = true; }
+    flaky_key::copies_left = 1 << 30;
+    std::vector<int> flaky_order;
+    while(std::optional<flaky_key> key = flaky_inbox.try_pop()) flaky_order.push_back(key->value);
+    check("mpsc_heap republishes a batch whose drain throws", drain_failed &&
+        flaky_order == one_to_ten);
+
+    binomial_heap<int> emptied;
+    bool top_threw = false, pop_threw = false;
+    try { emptied.top(); }
+    catch(const std::out_of_range&) { top_threw = true; }
+    try { emptied.pop(); }
+    catch(const std::out_of_range&) { pop_threw = true; }
+    bool nothing_extracted = !emptied.try_extract();
+    emptied.insert(3);
+    std::optional<int> extracted = emptied.try_extract();
+    check("top() and pop() throw on an empty heap while try_extract() returns nullopt",
+        top_threw && pop_threw && nothing_extracted && extracted == 3 && !emptied.try_extract());
+
+    binomial_heap<std::unique_ptr<int>, pointee_less> owning, owning_rhs;
+    for(int n = 10; n > 5; --n) owning.emplace(new int(n));
+    for(int n = 5; n > 0; --n) owning_rhs.insert(std::make_unique<int>(n));
+    owning.merge(owning_rhs);
+    binomial_heap<std::unique_ptr<int>, pointee_less>::iterator owned_eleven =
+        owning.iter_emplace(new int(11));
+    owning.decrease_key(owned_eleven, std::make_unique<int>(0));
+    std::vector<int> owned_order;
+    while(!owning.empty()) owned_order.push_back(*owning.pop());
+    std::vector<int> zero_to_ten(11);
+    std::iota(zero_to_ten.begin(), zero_to_ten.end(), 0);
+    check("move-only keys can be emplaced, inserted, merged, decreased and popped",
+        owned_order == zero_to_ten);
+
+    multi_queue<int> sparse(1, 64);
+    sparse.sample_rank_error(1);
+    bool sparse_popped = true;
+    for(int n = 0; n < 20; ++n) {
+        sparse.push(n);
+        sparse_popped = sparse_popped && sparse.try_pop() == n;
+    }
+    multi_queue<int>::statistics sparse_stats = sparse.stats();
+    check("multi_queue samples rank error on fallback sweeps as well as on paired pops",
+        sparse_popped && sparse_stats.pops == 20 && sparse_stats.rank_samples == 20);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,267 @@
+/**
+ *  @file   bounded_heap.h
+ *  @brief  A fixed-capacity priority queue built on binomial_heap that retains only the best keys
+ *          it has been offered, for top-k scans over streams too large to hold in memory.
+ * 
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef BOUNDED_HEAP
+#define BOUNDED_HEAP 1
+#include "binomial_heap.h"
+
+/**
+ *  @brief  A priority queue that holds at most a fixed number of keys. Once it is full, a key that
+ *          is no better than the worst retained key is rejected in O(1) time, and any other key
+ *          evicts the worst retained key. Memory use is O(capacity) however many keys are offered.
+ *  @tparam T the type of the keys
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class bounded_heap {
+public:
+    explicit bounded_heap(size_t capacity, const Comp& compare = Comp());
+    bounded_heap(const bounded_heap&) = delete;
+    bounded_heap(bounded_heap&& rhs) = default;
+    bounded_heap& operator=(const bounded_heap&) = delete;
+    bounded_heap& operator=(bounded_heap&& rhs) = default;
+    size_t size() const;
+    size_t capacity() const;
+    bool empty() const;
+    bool full() const;
+    const T& top() const;
+    const T& worst() const;
+    T pop();
+    T pop_worst();
+    bool accepts(const T& key) const;
+    bool insert(const T& key);
+    bool insert(T&& key);
+private:
+    struct slot;
+    struct entry {
+        mutable T key;
+        size_t slot;
+    };
+    struct entry_compare {
+        bool operator()(const entry& lhs, const entry& rhs) const;
+        Comp compare;
+    };
+    struct worst_compare {
+        bool operator()(size_t lhs, size_t rhs) const;
+        Comp compare;
+        const slot* slots;
+    };
+    using best_heap = binomial_heap<entry, entry_compare>;
+    using worst_heap = binomial_heap<size_t, worst_compare>;
+    struct slot {
+        typename best_heap::iterator best;
+        typename worst_heap::iterator worst;
+        size_t next_free;
+    };
+    template<class Key> bool push(Key&& key);
+    void release(size_t index);
+    Comp compare;
+    size_t _capacity;
+    std::unique_ptr<slot[]> slots;
+    size_t free_head;
+    best_heap best;
+    worst_heap worst_keys;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               bounded_heap comparator implementations                            *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Compares two entries by key only
+ *  @param[in]  lhs the left-hand entry
+ *  @param[in]  rhs the right-hand entry
+ *  @return     the result of the key comparison
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::entry_compare::operator()(
+    const entry& lhs,
+    const entry& rhs
+) const { return compare(lhs.key, rhs.key); }
+
+/**
+ *  @brief      Compares the keys held in two slots in reverse, so that the worst key is on top
+ *  @param[in]  lhs the left-hand slot
+ *  @param[in]  rhs the right-hand slot
+ *  @return     true if the key in lhs is worse than the key in rhs. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::worst_compare::operator()(size_t lhs, size_t rhs) const {
+    return compare((*slots[rhs].best).key, (*slots[lhs].best).key);
+}
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                   bounded_heap implementation                                    *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructor for the bounded_heap class. Every slot is allocated up front.
+ *  @param[in]  capacity the maximum number of keys to be retained
+ *  @param[in]  compare the comparison functor for keys, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+bounded_heap<T, Comp>::bounded_heap(size_t capacity, const Comp& compare) :
+    compare(compare),
+    _capacity(capacity),
+    slots(new slot[capacity]),
+    free_head(0),
+    best(entry_compare{compare}),
+    worst_keys(worst_compare{compare, slots.get()}) {
+    for(size_t i = 0; i < capacity; ++i) slots[i].next_free = i + 1;
+}
+
+/**
+ *  @brief  Gets the number of keys retained
+ *  @return the number of keys retained
+ */
+template<typename T, typename Comp>
+size_t bounded_heap<T, Comp>::size() const { return best.size(); }
+
+/**
+ *  @brief  Gets the maximum number of keys retained
+ *  @return the capacity the heap was constructed with
+ */
+template<typename T, typename Comp>
+size_t bounded_heap<T, Comp>::capacity() const { return _capacity; }
+
+/**
+ *  @brief  Returns whether or not the heap is empty
+ *  @return true if no keys are retained. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::empty() const { return best.empty(); }
+
+/**
+ *  @brief  Returns whether or not the heap is at capacity
+ *  @return true if the next accepted key will evict another. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::full() const { return best.size() == _capacity; }
+
+/**
+ *  @brief  Gets the best retained key. O(1) time.
+ *  @return the best retained key, by reference
+ */
+template<typename T, typename Comp>
+const T& bounded_heap<T, Comp>::top() const { return best.top().key; }
+
+/**
+ *  @brief  Gets the worst retained key, which is the next to be evicted. O(1) time.
+ *  @return the worst retained key, by reference
+ */
+template<typename T, typename Comp>
+const T& bounded_heap<T, Comp>::worst() const {
+    return (*slots[worst_keys.top()].best).key;
+}
+
+/**
+ *  @brief  Removes the best retained key. O(log k) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T bounded_heap<T, Comp>::pop() {
+    size_t index = best.top().slot;
+    worst_keys.remove(slots[index].worst);
+    entry popped = best.pop();
+    release(index);
+    return std::move(popped.key);
+}
+
+/**
+ *  @brief  Removes the worst retained key. O(log k) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T bounded_heap<T, Comp>::pop_worst() {
+    size_t index = worst_keys.pop();
+    T key = std::move((*slots[index].best).key);
+    best.remove(slots[index].best);
+    release(index);
+    return key;
+}
+
+/**
+ *  @brief      Checks whether a key would be retained without inserting it. O(1) time.
+ *  @param[in]  key the key to be checked
+ *  @return     true if the heap has room or key is better than the worst retained key. Otherwise,
+ *              false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::accepts(const T& key) const {
+    return !full() || (_capacity && compare(key, worst()));
+}
+
+/**
+ *  @brief      Offers a key to the heap. O(1) time if it is rejected, O(log k) time otherwise.
+ *  @param[in]  key the key to be offered
+ *  @return     true if key was retained. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::insert(const T& key) { return push(key); }
+
+/**
+ *  @brief      Offers a key to the heap, moving it in only if it is retained. O(1) time if it is
+ *              rejected, O(log k) time otherwise.
+ *  @param[in]  key the key to be offered
+ *  @return     true if key was retained. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool bounded_heap<T, Comp>::insert(T&& key) { return push(std::move(key)); }
+
+/**
+ *  @brief      Retains a key, evicting the worst retained key if the heap is full
+ *  @param[in]  key the key to be offered
+ *  @return     true if key was retained. Otherwise, false
+ */
+template<typename T, typename Comp>
+template<class Key>
+bool bounded_heap<T, Comp>::push(Key&& key) {
+    if(!accepts(key)) return false;
+    size_t index;
+    if(full()) {
+        index = worst_keys.pop();
+        best.remove(slots[index].best);
+    }
+    else {
+        index = free_head;
+        free_head = slots[index].next_free;
+    }
+    try {
+        slots[index].best = best.iter_emplace(entry{std::forward<Key>(key), index});
+    } catch(...) {
+        release(index);
+        throw;
+    }
+    try {
+        slots[index].worst = worst_keys.iter_insert(index);
+    } catch(...) {
+        best.remove(slots[index].best);
+        release(index);
+        throw;
+    }
+    return true;
+}
+
+/**
+ *  @brief      Returns a slot to the free list
+ *  @param[in]  index the slot to be freed
+ */
+template<typename T, typename Comp>
+void bounded_heap<T, Comp>::release(size_t index) {
+    slots[index] = slot{};
+    slots[index].next_free = free_head;
+    free_head = index;
+}
+#endif
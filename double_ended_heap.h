@@ -0,0 +1,556 @@
+/**
+ *  @file   double_ended_heap.h
+ *  @brief  A mergeable double-ended priority queue that threads a min-ordered and a max-ordered
+ *          binomial forest through a single set of nodes.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef DOUBLE_ENDED_HEAP
+#define DOUBLE_ENDED_HEAP 1
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ *  @brief  A double-ended binomial heap. Every key is stored once, in a node that carries one set
+ *          of binomial links for each end, so both ends are read in O(1) time and removed in
+ *          O(log n) time while two heaps can still be merged in O(log n) time.
+ *  @tparam T the type of the keys
+ *  @tparam Comp the comparison function that will be used for heap-ordering. min() is the key that
+ *          compares before every other key and max() is the key that compares after every other
+ *          key. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class double_ended_binomial_heap {
+public:
+    explicit double_ended_binomial_heap(const Comp& compare = Comp());
+    template<class InputIterator> double_ended_binomial_heap(
+        InputIterator start,
+        InputIterator stop,
+        const Comp& compare = Comp()
+    );
+    double_ended_binomial_heap(const double_ended_binomial_heap& rhs);
+    double_ended_binomial_heap(double_ended_binomial_heap&& rhs) noexcept;
+    double_ended_binomial_heap& operator=(const double_ended_binomial_heap& rhs);
+    double_ended_binomial_heap& operator=(double_ended_binomial_heap&& rhs) noexcept;
+    ~double_ended_binomial_heap();
+    size_t size() const;
+    bool empty() const;
+    const T& min() const;
+    const T& max() const;
+    T extract_min();
+    T extract_max();
+    void insert(const T& key);
+    void insert(T&& key);
+    template<class...Args> void emplace(Args&&...args);
+    void merge(const double_ended_binomial_heap& rhs);
+    void merge(double_ended_binomial_heap&& rhs);
+private:
+    struct node;
+    static constexpr size_t max_degree = 64;
+    static constexpr size_t low = 0;
+    static constexpr size_t high = 1;
+    struct links {
+        node* child;
+        node* sibling;
+        node* back;
+        unsigned char degree;
+    };
+    struct node {
+        template<class...Args> explicit node(std::in_place_t, Args&&...args);
+        T key;
+        links link[2];
+    };
+    struct forest {
+        forest();
+        node* trees[max_degree];
+        uint64_t occupied;
+        node* top;
+    };
+    bool before(size_t end, const node* lhs, const node* rhs) const;
+    node* parent(size_t end, node* target) const;
+    node* link(size_t end, node* root, node* child);
+    void add_tree(size_t end, node* tree);
+    void set_top(size_t end);
+    void remove_root(size_t end, node* root);
+    void swap_with_parent(size_t end, node* target, node* parent);
+    void unlink(size_t end, node* target);
+    void insert_node(node* added);
+    T extract(size_t end);
+    void insert_tree(const node* root);
+    void destroy_tree(node* root);
+    void delete_trees();
+    Comp compare;
+    forest ends[2];
+    size_t _size;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                     double_ended_binomial_heap node and forest implementation                    *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructs a detached node with its key built in place
+ *  @param[in]  args the arguments to be forwarded to the constructor of the key
+ */
+template<typename T, typename Comp>
+template<class...Args>
+double_ended_binomial_heap<T, Comp>::node::node(std::in_place_t, Args&&...args) :
+    key(std::forward<Args>(args)...),
+    link{{nullptr, nullptr, nullptr, 0}, {nullptr, nullptr, nullptr, 0}} {}
+
+/**
+ *  @brief  Constructs an empty forest
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>::forest::forest() : trees(), occupied(0), top(nullptr) {}
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               double_ended_binomial_heap implementation                          *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Default constructor for the double_ended_binomial_heap class
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>::double_ended_binomial_heap(const Comp& compare) :
+    compare(compare),
+    _size(0) {}
+
+/**
+ *  @brief      Range constructor for the double_ended_binomial_heap class
+ *  @param[in]  start the beginning of the range to be inserted into the heap
+ *  @param[in]  stop the end of the range to be inserted into the heap
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+template<class InputIterator>
+double_ended_binomial_heap<T, Comp>::double_ended_binomial_heap(
+    InputIterator start,
+    InputIterator stop,
+    const Comp& compare
+) : double_ended_binomial_heap(compare) {
+    for(; start != stop; ++start) emplace(*start);
+}
+
+/**
+ *  @brief      Copy constructor for the double_ended_binomial_heap class. Performs a deep copy.
+ *  @param[in]  rhs the heap whose contents are to be copied
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>::double_ended_binomial_heap(
+    const double_ended_binomial_heap<T, Comp>& rhs
+) : double_ended_binomial_heap(rhs.compare) { this->operator=(rhs); }
+
+/**
+ *  @brief      Move constructor for the double_ended_binomial_heap class
+ *  @param[in]  rhs the heap whose contents are to be moved
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>::double_ended_binomial_heap(
+    double_ended_binomial_heap<T, Comp>&& rhs
+) noexcept : double_ended_binomial_heap(rhs.compare) { this->operator=(std::move(rhs)); }
+
+/**
+ *  @brief      Assignment operator for the double_ended_binomial_heap class. Performs a deep copy
+ *              by reinserting every key of rhs. O(n) time.
+ *  @param[in]  rhs the heap to be copied
+ *  @return     this heap by reference for operator chaining
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>& double_ended_binomial_heap<T, Comp>::operator=(
+    const double_ended_binomial_heap<T, Comp>& rhs
+) {
+    if(this == &rhs) return *this;
+    delete_trees();
+    compare = rhs.compare;
+    for(size_t degree = 0; degree < max_degree; ++degree)
+        if(rhs.ends[low].occupied & (uint64_t(1) << degree))
+            insert_tree(rhs.ends[low].trees[degree]);
+    return *this;
+}
+
+/**
+ *  @brief      Move assignment operator for the double_ended_binomial_heap class
+ *  @param[in]  rhs the heap to be moved
+ *  @return     this heap by reference for operator chaining
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>& double_ended_binomial_heap<T, Comp>::operator=(
+    double_ended_binomial_heap<T, Comp>&& rhs
+) noexcept {
+    if(this == &rhs) return *this;
+    delete_trees();
+    compare = std::move(rhs.compare);
+    ends[low] = rhs.ends[low];
+    ends[high] = rhs.ends[high];
+    _size = rhs._size;
+    rhs.ends[low] = rhs.ends[high] = forest();
+    rhs._size = 0;
+    return *this;
+}
+
+/**
+ *  @brief  Destructor for the double_ended_binomial_heap class
+ */
+template<typename T, typename Comp>
+double_ended_binomial_heap<T, Comp>::~double_ended_binomial_heap() { delete_trees(); }
+
+/**
+ *  @brief  Gets the size of the heap
+ *  @return the size of the heap
+ */
+template<typename T, typename Comp>
+size_t double_ended_binomial_heap<T, Comp>::size() const { return _size; }
+
+/**
+ *  @brief  Returns whether or not the heap is empty
+ *  @return true if the heap has zero elements. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool double_ended_binomial_heap<T, Comp>::empty() const { return !_size; }
+
+/**
+ *  @brief  Gets the minimum key in the heap. O(1) time.
+ *  @return the minimum key, by reference
+ */
+template<typename T, typename Comp>
+const T& double_ended_binomial_heap<T, Comp>::min() const {
+    if(!_size) throw std::out_of_range("Empty");
+    return ends[low].top->key;
+}
+
+/**
+ *  @brief  Gets the maximum key in the heap. O(1) time.
+ *  @return the maximum key, by reference
+ */
+template<typename T, typename Comp>
+const T& double_ended_binomial_heap<T, Comp>::max() const {
+    if(!_size) throw std::out_of_range("Empty");
+    return ends[high].top->key;
+}
+
+/**
+ *  @brief  Removes the minimum key from the heap. O(log n) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T double_ended_binomial_heap<T, Comp>::extract_min() { return extract(low); }
+
+/**
+ *  @brief  Removes the maximum key from the heap. O(log n) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T double_ended_binomial_heap<T, Comp>::extract_max() { return extract(high); }
+
+/**
+ *  @brief      Inserts a key into the heap. O(1) am. time.
+ *  @param[in]  key the key to be inserted into the heap
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::insert(const T& key) { emplace(key); }
+
+/**
+ *  @brief      Inserts a key into the heap by moving it in. O(1) am. time.
+ *  @param[in]  key the key to be inserted into the heap
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::insert(T&& key) { emplace(std::move(key)); }
+
+/**
+ *  @brief      Constructs a key in place and inserts it into the heap. O(1) am. time.
+ *  @param[in]  args the arguments to be forwarded to the constructor of the key
+ */
+template<typename T, typename Comp>
+template<class...Args>
+void double_ended_binomial_heap<T, Comp>::emplace(Args&&...args) {
+    insert_node(new node(std::in_place, std::forward<Args>(args)...));
+}
+
+/**
+ *  @brief      Merges a copy of rhs into this heap. O(m) time for a heap rhs of size m.
+ *  @param[in]  rhs the heap to be copied into this one
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::merge(const double_ended_binomial_heap<T, Comp>& rhs) {
+    merge(double_ended_binomial_heap<T, Comp>(rhs));
+}
+
+/**
+ *  @brief          Merges rhs into this heap without copying any keys, leaving rhs empty. Both
+ *                  forests of rhs are carried into the matching forests of this heap.
+ *                  O(log n) time.
+ *  @param[in, out] rhs the heap to be merged into this one
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::merge(double_ended_binomial_heap<T, Comp>&& rhs) {
+    if(this == &rhs) return;
+    for(size_t end: {low, high}) {
+        forest& merged = rhs.ends[end];
+        node*& top = ends[end].top;
+        if(merged.top && (!top || before(end, merged.top, top))) top = merged.top;
+        for(size_t degree = 0; degree < max_degree; ++degree)
+            if(merged.occupied & (uint64_t(1) << degree)) add_tree(end, merged.trees[degree]);
+        merged = forest();
+    }
+    _size += rhs._size;
+    rhs._size = 0;
+}
+
+/**
+ *  @brief      Orders two nodes for one end of the heap
+ *  @param[in]  end low to order by Comp, high to order by the reverse of Comp
+ *  @param[in]  lhs the left-hand node
+ *  @param[in]  rhs the right-hand node
+ *  @return     true if lhs belongs strictly closer to the top of end than rhs. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool double_ended_binomial_heap<T, Comp>::before(
+    size_t end,
+    const typename double_ended_binomial_heap<T, Comp>::node* lhs,
+    const typename double_ended_binomial_heap<T, Comp>::node* rhs
+) const { return end == low ? compare(lhs->key, rhs->key) : compare(rhs->key, lhs->key); }
+
+/**
+ *  @brief      Finds the parent of a node in one forest. As in binomial_heap, only a first child
+ *              links back to its parent and every other child links back to its previous sibling.
+ *  @param[in]  end the forest to be searched
+ *  @param[in]  target the node whose parent is to be found
+ *  @return     the parent of target, or nullptr if target is a root
+ */
+template<typename T, typename Comp>
+typename double_ended_binomial_heap<T, Comp>::node* double_ended_binomial_heap<T, Comp>::parent(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* target
+) const {
+    while(target->link[end].back && target->link[end].back->link[end].child != target)
+        target = target->link[end].back;
+    return target->link[end].back;
+}
+
+/**
+ *  @brief      Makes one root the first child of another root of the same degree
+ *  @param[in]  end the forest holding both roots
+ *  @param[in]  root the root that stays a root
+ *  @param[in]  child the root that becomes a child
+ *  @return     root
+ */
+template<typename T, typename Comp>
+typename double_ended_binomial_heap<T, Comp>::node* double_ended_binomial_heap<T, Comp>::link(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* root,
+    typename double_ended_binomial_heap<T, Comp>::node* child
+) {
+    links& parent_links = root->link[end];
+    child->link[end].sibling = parent_links.child;
+    if(parent_links.child) parent_links.child->link[end].back = child;
+    child->link[end].back = root;
+    parent_links.child = child;
+    ++parent_links.degree;
+    return root;
+}
+
+/**
+ *  @brief      Adds a tree to one forest like a carry in a binary counter. The current top of the
+ *              forest always stays a root.
+ *  @param[in]  end the forest the tree is to be added to
+ *  @param[in]  tree the root of the tree to be added
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::add_tree(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* tree
+) {
+    forest& roots = ends[end];
+    size_t degree = tree->link[end].degree;
+    for(; roots.occupied & (uint64_t(1) << degree); ++degree) {
+        roots.occupied &= ~(uint64_t(1) << degree);
+        node* root = roots.trees[degree];
+        bool keep_tree = tree == roots.top || (root != roots.top && before(end, tree, root));
+        tree = keep_tree ? link(end, tree, root) : link(end, root, tree);
+    }
+    roots.trees[degree] = tree;
+    roots.occupied |= uint64_t(1) << degree;
+}
+
+/**
+ *  @brief      Finds the top of one forest by scanning its roots. O(log n) time.
+ *  @param[in]  end the forest whose top is to be found
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::set_top(size_t end) {
+    forest& roots = ends[end];
+    roots.top = nullptr;
+    for(size_t degree = 0; degree < max_degree; ++degree) {
+        if(!(roots.occupied & (uint64_t(1) << degree))) continue;
+        node* root = roots.trees[degree];
+        if(!roots.top || before(end, root, roots.top)) roots.top = root;
+    }
+}
+
+/**
+ *  @brief      Detaches a root from one forest and carries its children back in as roots. The
+ *              node itself is left allocated and still linked into the other forest.
+ *  @param[in]  end the forest holding root
+ *  @param[in]  root the root to be detached
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::remove_root(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* root
+) {
+    forest& roots = ends[end];
+    roots.occupied &= ~(uint64_t(1) << root->link[end].degree);
+    roots.top = nullptr;
+    node* child = root->link[end].child;
+    while(child) {
+        node* next = child->link[end].sibling;
+        child->link[end].sibling = child->link[end].back = nullptr;
+        add_tree(end, child);
+        child = next;
+    }
+    set_top(end);
+}
+
+/**
+ *  @brief      Exchanges the positions of a node and its parent in one forest in constant time,
+ *              exactly as binomial_heap does. The other forest and every key are left untouched.
+ *  @param[in]  end the forest holding both nodes
+ *  @param[in]  target the node to be moved up one level
+ *  @param[in]  parent the current parent of target
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::swap_with_parent(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* target,
+    typename double_ended_binomial_heap<T, Comp>::node* parent
+) {
+    links& moved = target->link[end];
+    links& above = parent->link[end];
+    node* parent_back = above.back;
+    node* parent_sibling = above.sibling;
+    node* target_children = moved.child;
+    if(above.child == target) {
+        moved.child = parent;
+        above.back = target;
+    } else {
+        moved.child = above.child;
+        moved.child->link[end].back = target;
+        moved.back->link[end].sibling = parent;
+        above.back = moved.back;
+    }
+    above.sibling = moved.sibling;
+    if(above.sibling) above.sibling->link[end].back = parent;
+    above.child = target_children;
+    if(target_children) target_children->link[end].back = parent;
+    moved.back = parent_back;
+    moved.sibling = parent_sibling;
+    if(parent_sibling) parent_sibling->link[end].back = target;
+    if(!parent_back) ends[end].trees[above.degree] = target;
+    else if(parent_back->link[end].child == parent) parent_back->link[end].child = target;
+    else parent_back->link[end].sibling = target;
+    std::swap(moved.degree, above.degree);
+}
+
+/**
+ *  @brief      Removes a node from one forest by swapping it up to the root of its tree without
+ *              comparing any keys, and then detaching that root. O(log n) time.
+ *  @param[in]  end the forest the node is to be removed from
+ *  @param[in]  target the node to be removed
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::unlink(
+    size_t end,
+    typename double_ended_binomial_heap<T, Comp>::node* target
+) {
+    for(node* above = parent(end, target); above; above = parent(end, target))
+        swap_with_parent(end, target, above);
+    remove_root(end, target);
+}
+
+/**
+ *  @brief      Links a new node into both forests
+ *  @param[in]  added the node to be inserted
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::insert_node(
+    typename double_ended_binomial_heap<T, Comp>::node* added
+) {
+    for(size_t end: {low, high}) {
+        if(!ends[end].top || before(end, added, ends[end].top)) ends[end].top = added;
+        add_tree(end, added);
+    }
+    ++_size;
+}
+
+/**
+ *  @brief      Removes the top of one end, unlinking the same node from the other forest
+ *  @param[in]  end low to remove the minimum, high to remove the maximum
+ *  @return     the removed key
+ */
+template<typename T, typename Comp>
+T double_ended_binomial_heap<T, Comp>::extract(size_t end) {
+    if(!_size) throw std::out_of_range("Empty");
+    node* target = ends[end].top;
+    remove_root(end, target);
+    unlink(end ^ 1, target);
+    T key = std::move(target->key);
+    delete target;
+    --_size;
+    return key;
+}
+
+/**
+ *  @brief      Inserts a copy of every key in a tree of the low forest of another heap
+ *  @param[in]  root the root of the tree to be copied
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::insert_tree(
+    const typename double_ended_binomial_heap<T, Comp>::node* root
+) {
+    emplace(root->key);
+    for(const node* child = root->link[low].child; child; child = child->link[low].sibling)
+        insert_tree(child);
+}
+
+/**
+ *  @brief      Deletes every node of a tree of the low forest. Each node is deleted once because
+ *              every node belongs to exactly one tree of each forest.
+ *  @param[in]  root the root of the tree to be deleted
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::destroy_tree(
+    typename double_ended_binomial_heap<T, Comp>::node* root
+) {
+    node* child = root->link[low].child;
+    while(child) {
+        node* next = child->link[low].sibling;
+        destroy_tree(child);
+        child = next;
+    }
+    delete root;
+}
+
+/**
+ *  @brief  Deletes every node and empties both forests
+ */
+template<typename T, typename Comp>
+void double_ended_binomial_heap<T, Comp>::delete_trees() {
+    for(size_t degree = 0; degree < max_degree; ++degree)
+        if(ends[low].occupied & (uint64_t(1) << degree)) destroy_tree(ends[low].trees[degree]);
+    ends[low] = ends[high] = forest();
+    _size = 0;
+}
+#endif
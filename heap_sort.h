@@ -5,14 +5,120 @@
  * 
  *  @author Nicky Kriplani
  *  @date   February 12, 2023
+ *  @author agent (parallel binom_heap_sort and run_loser_tree)
+ *  @date   October 16, 2026
 */
 #ifndef HEAP_SORT
 #define HEAP_SORT 1
 #include "binomial_heap.h"
 
+/**
+ *  @brief  Execution policy tag selecting the parallel binom_heap_sort overload. The standard
+ *          <execution> policies are not used because including that header makes every program
+ *          link against TBB on some toolchains.
+ */
+struct binom_parallel_policy {
+    size_t threads = 0;
+};
+
+/**
+ *  @brief  Parallel policy that uses every hardware thread
+ */
+inline constexpr binom_parallel_policy binom_par{};
+
+/**
+ *  @brief  A tournament tree of losers over sorted runs, used for k-way merging. Each pop costs
+ *          one comparison per level of the tree.
+ *  @tparam RandomIt the iterator type of the runs
+ *  @tparam Comp the comparison function the runs are sorted by
+ */
+template<class RandomIt, typename Comp>
+class run_loser_tree {
+public:
+    run_loser_tree(
+        const std::vector<std::pair<RandomIt, RandomIt>>& runs,
+        const Comp& compare
+    );
+    bool empty() const;
+    RandomIt top() const;
+    void advance();
+private:
+    bool beats(size_t lhs, size_t rhs) const;
+    std::vector<std::pair<RandomIt, RandomIt>> runs;
+    std::vector<size_t> losers;
+    size_t winner;
+    Comp compare;
+};
+
+/**
+ *  @brief      Constructor for the run_loser_tree class. Plays the initial tournament. O(k) time.
+ *  @param[in]  runs the [begin, end) ranges of the sorted runs
+ *  @param[in]  compare the comparison function the runs are sorted by
+ */
+template<class RandomIt, typename Comp>
+run_loser_tree<RandomIt, Comp>::run_loser_tree(
+    const std::vector<std::pair<RandomIt, RandomIt>>& runs,
+    const Comp& compare
+) : runs(runs), losers(runs.size()), winner(0), compare(compare) {
+    size_t count = runs.size();
+    std::vector<size_t> winners(2 * count);
+    for(size_t i = 0; i < count; ++i) winners[count + i] = i;
+    for(size_t node = count - 1; node >= 1; --node) {
+        size_t lhs = winners[2 * node], rhs = winners[2 * node + 1];
+        winners[node] = beats(rhs, lhs) ? rhs : lhs;
+        losers[node] = winners[node] == lhs ? rhs : lhs;
+    }
+    winner = count > 1 ? winners[1] : 0;
+}
+
+/**
+ *  @brief  Returns whether every run is exhausted
+ *  @return true if no elements are left. Otherwise, false
+ */
+template<class RandomIt, typename Comp>
+bool run_loser_tree<RandomIt, Comp>::empty() const {
+    return runs[winner].first == runs[winner].second;
+}
+
+/**
+ *  @brief  Gets the smallest remaining element
+ *  @return an iterator to the smallest element at the head of any run
+ */
+template<class RandomIt, typename Comp>
+RandomIt run_loser_tree<RandomIt, Comp>::top() const { return runs[winner].first; }
+
+/**
+ *  @brief  Consumes the smallest remaining element and replays its path to the root. O(log k)
+ *          time.
+ */
+template<class RandomIt, typename Comp>
+void run_loser_tree<RandomIt, Comp>::advance() {
+    ++runs[winner].first;
+    size_t current = winner;
+    for(size_t node = (runs.size() + winner) / 2; node >= 1; node /= 2)
+        if(beats(losers[node], current)) std::swap(losers[node], current);
+    winner = current;
+}
+
+/**
+ *  @brief      Decides a match between the heads of two runs. Exhausted runs lose every match and
+ *              ties go to the lower run so that merging is stable.
+ *  @param[in]  lhs the index of the first run
+ *  @param[in]  rhs the index of the second run
+ *  @return     true if lhs wins. Otherwise, false
+ */
+template<class RandomIt, typename Comp>
+bool run_loser_tree<RandomIt, Comp>::beats(size_t lhs, size_t rhs) const {
+    if(runs[lhs].first == runs[lhs].second) return false;
+    if(runs[rhs].first == runs[rhs].second) return true;
+    if(compare(*runs[lhs].first, *runs[rhs].first)) return true;
+    if(compare(*runs[rhs].first, *runs[lhs].first)) return false;
+    return lhs < rhs;
+}
+
 /**
  *  @brief Sorts the data beginning at start and ending at stop using the comparison function
- *         provided.
+ *         provided. Elements are moved into the heap and moved back out, never copied.
  * 
  *  @param[in, out] start   the beginning of the range in which data is to be sorted
  *  @param[in, out] stop    the end of the range in which data is to be sorted
@@ -20,7 +126,54 @@
  */
 template<class InputIterator, typename Comp = std::less<typename InputIterator::value_type>>
 void binom_heap_sort(InputIterator start, InputIterator stop, const Comp& compare = Comp()) {
-    binomial_heap<typename InputIterator::value_type, Comp> heap(start, stop, compare);
-    for(; start != stop; ++start) *start = heap.extract();
+    binomial_heap<typename InputIterator::value_type, Comp> heap(
+        std::make_move_iterator(start),
+        std::make_move_iterator(stop),
+        compare
+    );
+    for(; start != stop; ++start) *start = heap.pop();
+}
+
+/**
+ *  @brief Sorts the data beginning at start and ending at stop in parallel. The range is split
+ *         into one run per thread, each run is sorted with its own binomial heap, and the sorted
+ *         runs are k-way merged through a loser tree into a buffer that is moved back.
+ * 
+ *  @param[in]      policy  the number of threads to sort with, 0 for every hardware thread
+ *  @param[in, out] start   the beginning of the range in which data is to be sorted
+ *  @param[in, out] stop    the end of the range in which data is to be sorted
+ *  @param[in]      compare the comparison function to be used for sorting, defaults to std::less
+ */
+template<class RandomIt, typename Comp = std::less<typename RandomIt::value_type>>
+void binom_heap_sort(
+    const binom_parallel_policy& policy,
+    RandomIt start,
+    RandomIt stop,
+    const Comp& compare = Comp()
+) {
+    const size_t min_run = size_t(1) << 14;
+    size_t count = stop - start;
+    size_t threads = policy.threads ? policy.threads : std::thread::hardware_concurrency();
+    size_t run_count = std::min(std::max<size_t>(threads, 1), std::max<size_t>(count / min_run, 1));
+    if(run_count <= 1) {
+        binom_heap_sort(start, stop, compare);
+        return;
+    }
+    std::vector<std::pair<RandomIt, RandomIt>> runs;
+    std::vector<std::future<void>> tasks;
+    for(size_t i = 0; i < run_count; ++i) {
+        RandomIt run_start = start + count * i / run_count;
+        RandomIt run_stop = start + count * (i + 1) / run_count;
+        runs.emplace_back(run_start, run_stop);
+        tasks.push_back(std::async(std::launch::async, [run_start, run_stop, &compare] {
+            binom_heap_sort(run_start, run_stop, compare);
+        }));
+    }
+    for(std::future<void>& task: tasks) task.get();
+    std::vector<typename RandomIt::value_type> merged;
+    merged.reserve(count);
+    for(run_loser_tree<RandomIt, Comp> tree(runs, compare); !tree.empty(); tree.advance())
+        merged.push_back(std::move(*tree.top()));
+    std::move(merged.begin(), merged.end(), start);
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,214 @@
+/**
+ *  @file   keyed_heap.h
+ *  @brief  A priority queue built on binomial_heap that keeps large payloads out of the heap
+ *          nodes, so that heap-ordering only ever touches compact keys.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef KEYED_HEAP
+#define KEYED_HEAP 1
+#include "binomial_heap.h"
+
+/**
+ *  @brief  A priority queue of key/value pairs ordered by key alone. Nodes hold only the key and
+ *          the index of the value, and the values live in a dense array that is kept free of gaps,
+ *          so every comparison touches a small node instead of a whole record.
+ *  @tparam Key the type of the keys that are compared
+ *  @tparam Value the type of the payloads, which are only moved, never compared
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename Key, typename Value, typename Comp = std::less<Key>>
+class keyed_binomial_heap {
+public:
+    explicit keyed_binomial_heap(const Comp& compare = Comp());
+    keyed_binomial_heap(const keyed_binomial_heap& rhs);
+    keyed_binomial_heap(keyed_binomial_heap&& rhs) = default;
+    keyed_binomial_heap& operator=(const keyed_binomial_heap& rhs);
+    keyed_binomial_heap& operator=(keyed_binomial_heap&& rhs) = default;
+    size_t size() const;
+    bool empty() const;
+    const Key& top_key() const;
+    const Value& top_value() const;
+    std::pair<Key, Value> pop();
+    void insert(Key key, Value value);
+    template<class...Args> void emplace(Key key, Args&&...args);
+    void merge(keyed_binomial_heap&& rhs);
+private:
+    struct entry {
+        Key key;
+        mutable size_t payload;
+    };
+    struct entry_compare {
+        bool operator()(const entry& lhs, const entry& rhs) const;
+        Comp compare;
+    };
+    using heap_type = binomial_heap<entry, entry_compare>;
+    using heap_iterator = typename heap_type::iterator;
+    Comp compare;
+    heap_type heap;
+    std::vector<Value> payloads;
+    std::vector<heap_iterator> owners;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                keyed_binomial_heap implementation                                *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Compares two entries by key only
+ *  @param[in]  lhs the left-hand entry
+ *  @param[in]  rhs the right-hand entry
+ *  @return     the result of the key comparison
+ */
+template<typename Key, typename Value, typename Comp>
+bool keyed_binomial_heap<Key, Value, Comp>::entry_compare::operator()(
+    const entry& lhs,
+    const entry& rhs
+) const { return compare(lhs.key, rhs.key); }
+
+/**
+ *  @brief      Default constructor for the keyed_binomial_heap class
+ *  @param[in]  compare the comparison functor for keys, defaults to std::less<Key>
+ */
+template<typename Key, typename Value, typename Comp>
+keyed_binomial_heap<Key, Value, Comp>::keyed_binomial_heap(const Comp& compare) :
+    compare(compare),
+    heap(entry_compare{compare}) {}
+
+/**
+ *  @brief      Copy constructor for the keyed_binomial_heap class. The entries of rhs are inserted
+ *              into a heap of this object's own, so that owners refers to this object's nodes
+ *              rather than to those of rhs. O(n) time.
+ *  @param[in]  rhs the heap to be copied
+ */
+template<typename Key, typename Value, typename Comp>
+keyed_binomial_heap<Key, Value, Comp>::keyed_binomial_heap(
+    const keyed_binomial_heap<Key, Value, Comp>& rhs
+) :
+    compare(rhs.compare),
+    heap(entry_compare{rhs.compare}),
+    payloads(rhs.payloads),
+    owners(rhs.owners.size()) {
+    rhs.heap.for_each([this](const entry& copied) {
+        owners[copied.payload] = heap.iter_insert(copied);
+    });
+}
+
+/**
+ *  @brief      Copy assignment operator for the keyed_binomial_heap class
+ *  @param[in]  rhs the heap to be copied
+ *  @return     this heap by reference for operator chaining
+ */
+template<typename Key, typename Value, typename Comp>
+keyed_binomial_heap<Key, Value, Comp>& keyed_binomial_heap<Key, Value, Comp>::operator=(
+    const keyed_binomial_heap<Key, Value, Comp>& rhs
+) {
+    if(this != &rhs) *this = keyed_binomial_heap(rhs);
+    return *this;
+}
+
+/**
+ *  @brief  Gets the number of pairs in the heap
+ *  @return the number of pairs in the heap
+ */
+template<typename Key, typename Value, typename Comp>
+size_t keyed_binomial_heap<Key, Value, Comp>::size() const { return heap.size(); }
+
+/**
+ *  @brief  Returns whether or not the heap is empty
+ *  @return true if the heap holds no pairs. Otherwise, false
+ */
+template<typename Key, typename Value, typename Comp>
+bool keyed_binomial_heap<Key, Value, Comp>::empty() const { return heap.empty(); }
+
+/**
+ *  @brief  Gets the minimum key
+ *  @return the minimum key, by reference
+ */
+template<typename Key, typename Value, typename Comp>
+const Key& keyed_binomial_heap<Key, Value, Comp>::top_key() const { return heap.top().key; }
+
+/**
+ *  @brief  Gets the value paired with the minimum key
+ *  @return the value paired with the minimum key, by reference
+ */
+template<typename Key, typename Value, typename Comp>
+const Value& keyed_binomial_heap<Key, Value, Comp>::top_value() const {
+    return payloads[heap.top().payload];
+}
+
+/**
+ *  @brief  Removes the pair with the minimum key. The last value in the store is moved into the
+ *          hole left behind, so the store stays dense. O(log n) time.
+ *  @return the removed key and its value
+ */
+template<typename Key, typename Value, typename Comp>
+std::pair<Key, Value> keyed_binomial_heap<Key, Value, Comp>::pop() {
+    entry popped = heap.pop();
+    size_t hole = popped.payload;
+    std::pair<Key, Value> result(std::move(popped.key), std::move(payloads[hole]));
+    if(hole != payloads.size() - 1) {
+        payloads[hole] = std::move(payloads.back());
+        owners[hole] = owners.back();
+        (*owners[hole]).payload = hole;
+    }
+    payloads.pop_back();
+    owners.pop_back();
+    return result;
+}
+
+/**
+ *  @brief      Inserts a pair into the heap. O(1) am. time.
+ *  @param[in]  key the key the pair is ordered by
+ *  @param[in]  value the payload to be stored with key
+ */
+template<typename Key, typename Value, typename Comp>
+void keyed_binomial_heap<Key, Value, Comp>::insert(Key key, Value value) {
+    emplace(std::move(key), std::move(value));
+}
+
+/**
+ *  @brief      Inserts a pair into the heap, constructing the value in place. O(1) am. time.
+ *  @param[in]  key the key the pair is ordered by
+ *  @param[in]  args the arguments to be forwarded to the constructor of the value
+ */
+template<typename Key, typename Value, typename Comp>
+template<class...Args>
+void keyed_binomial_heap<Key, Value, Comp>::emplace(Key key, Args&&...args) {
+    owners.reserve(owners.size() + 1);
+    payloads.emplace_back(std::forward<Args>(args)...);
+    try {
+        owners.push_back(heap.iter_emplace(entry{std::move(key), payloads.size() - 1}));
+    } catch(...) {
+        payloads.pop_back();
+        throw;
+    }
+}
+
+/**
+ *  @brief          Merges rhs into this heap, leaving rhs empty. The heaps themselves merge in
+ *                  O(log n) time; the values of rhs are appended to this store, which costs
+ *                  O(m) time for a heap rhs of size m.
+ *  @param[in, out] rhs the heap to be merged into this one
+ */
+template<typename Key, typename Value, typename Comp>
+void keyed_binomial_heap<Key, Value, Comp>::merge(keyed_binomial_heap<Key, Value, Comp>&& rhs) {
+    if(this == &rhs) return;
+    size_t offset = payloads.size();
+    payloads.reserve(offset + rhs.payloads.size());
+    owners.reserve(offset + rhs.owners.size());
+    for(size_t i = 0; i < rhs.payloads.size(); ++i) {
+        payloads.push_back(std::move(rhs.payloads[i]));
+        owners.push_back(rhs.owners[i]);
+        (*owners.back()).payload = offset + i;
+    }
+    heap.merge(std::move(rhs.heap));
+    rhs.payloads.clear();
+    rhs.owners.clear();
+}
+#endif
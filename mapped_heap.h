@@ -0,0 +1,319 @@
+/**
+ *  @file   mapped_heap.h
+ *  @brief  A read-mostly priority queue served straight from a memory-mapped heap snapshot, with
+ *          changes kept in an in-memory overlay.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef MAPPED_HEAP
+#define MAPPED_HEAP 1
+#include "binomial_heap.h"
+#include <system_error>
+#include <cerrno>
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#error "mapped_heap.h needs POSIX mmap"
+#endif
+
+/**
+ *  @brief  A priority queue opened from a file written by binomial_heap::save(). The file is
+ *          mapped read-only and never parsed: a key's children are found from its preorder offset
+ *          and degree, so top(), find() and for_each() read the mapping in place, and any number of
+ *          processes can share one image. The image is never written to. Extracting one of its keys
+ *          only replaces that subtree with its children in a small heap of subtree roots, and
+ *          inserted keys go to an in-memory binomial_heap that top() and extract() consult too.
+ *  @tparam T the type of the keys, which must be trivially copyable
+ *  @tparam Comp the comparison function that will be used for heap-ordering. It must order keys
+ *          the same way as the comparison of the heap that wrote the image. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class mapped_binomial_heap {
+    static_assert(
+        std::is_trivially_copyable<T>::value,
+        "Mapped images need trivially copyable keys"
+    );
+public:
+    explicit mapped_binomial_heap(const char* path, const Comp& compare = Comp());
+    mapped_binomial_heap(const mapped_binomial_heap&) = delete;
+    mapped_binomial_heap& operator=(const mapped_binomial_heap&) = delete;
+    ~mapped_binomial_heap();
+    size_t size() const;
+    size_t image_size() const;
+    bool empty() const;
+    const T& top() const;
+    T min() const;
+    T extract();
+    T pop();
+    void insert(const T& key);
+    void insert(T&& key);
+    template<class...Args> void emplace(Args&&...args);
+    const T& find(const T& key) const;
+    template<class Visitor> void for_each(Visitor visit) const;
+private:
+    struct subtree {
+        uint64_t index;
+        unsigned char degree;
+    };
+    struct subtree_compare {
+        bool operator()(const subtree& lhs, const subtree& rhs) const;
+        Comp compare;
+        const T* keys;
+    };
+    bool image_first() const;
+    const T* search(const subtree& root, const T& key) const;
+    template<class Visitor> void visit_subtree(const subtree& root, Visitor& visit) const;
+    Comp compare;
+    const unsigned char* base;
+    size_t length;
+    const T* keys;
+    size_t image_count;
+    binomial_heap<subtree, subtree_compare> image;
+    binomial_heap<T, Comp> overlay;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               mapped_binomial_heap implementation                                *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Compares two image subtrees by the keys at their roots
+ *  @param[in]  lhs the left-hand subtree
+ *  @param[in]  rhs the right-hand subtree
+ *  @return     the result of the key comparison
+ */
+template<typename T, typename Comp>
+bool mapped_binomial_heap<T, Comp>::subtree_compare::operator()(
+    const subtree& lhs,
+    const subtree& rhs
+) const { return compare(keys[lhs.index], keys[rhs.index]); }
+
+/**
+ *  @brief      Maps a heap snapshot read-only. Only the header and the degrees of the trees are
+ *              read; the keys are not touched until they are needed. Throws std::system_error if
+ *              the file cannot be opened or mapped, and std::runtime_error if it is not a snapshot
+ *              of T. O(number of trees) time.
+ *  @param[in]  path the path of a file written by binomial_heap::save()
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+mapped_binomial_heap<T, Comp>::mapped_binomial_heap(const char* path, const Comp& compare) :
+    compare(compare),
+    base(nullptr),
+    length(0),
+    keys(nullptr),
+    image_count(0),
+    image(subtree_compare{compare, nullptr}),
+    overlay(compare) {
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) throw std::system_error(errno, std::generic_category(), path);
+    struct stat status;
+    if(fstat(fd, &status) < 0) {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    length = size_t(status.st_size);
+    void* mapping = length ? mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    int error = errno;
+    close(fd);
+    if(mapping == MAP_FAILED) {
+        if(!length) throw std::runtime_error("Invalid heap snapshot header");
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    base = static_cast<const unsigned char*>(mapping);
+    try {
+        binomial_snapshot_header header;
+        if(length < sizeof(header)) throw std::runtime_error("Invalid heap snapshot header");
+        std::memcpy(&header, base, sizeof(header));
+        size_t offset = header.keys_offset(alignof(T));
+        if(!header.valid(sizeof(T)) || offset > length ||
+           header.size > (length - offset) / sizeof(T))
+            throw std::runtime_error("Invalid heap snapshot header");
+        const unsigned char* degrees = base + sizeof(header);
+        keys = reinterpret_cast<const T*>(base + offset);
+        image = binomial_heap<subtree, subtree_compare>(subtree_compare{compare, keys});
+        uint64_t index = 0;
+        for(uint32_t i = 0; i < header.tree_count; ++i) {
+            if(degrees[i] >= 63 || (uint64_t(1) << degrees[i]) > header.size - index)
+                throw std::runtime_error("Invalid heap snapshot header");
+            image.insert(subtree{index, degrees[i]});
+            index += uint64_t(1) << degrees[i];
+        }
+        if(index != header.size) throw std::runtime_error("Invalid heap snapshot header");
+        image_count = header.size;
+    } catch(...) {
+        munmap(const_cast<unsigned char*>(base), length);
+        throw;
+    }
+}
+
+/**
+ *  @brief  Destructor for the mapped_binomial_heap class. Unmaps the image.
+ */
+template<typename T, typename Comp>
+mapped_binomial_heap<T, Comp>::~mapped_binomial_heap() {
+    munmap(const_cast<unsigned char*>(base), length);
+}
+
+/**
+ *  @brief  Gets the number of keys in the heap, from the image and the overlay
+ *  @return the number of keys in the heap
+ */
+template<typename T, typename Comp>
+size_t mapped_binomial_heap<T, Comp>::size() const { return image_count + overlay.size(); }
+
+/**
+ *  @brief  Gets the number of keys still read from the image
+ *  @return the number of keys in the heap that live in the mapping
+ */
+template<typename T, typename Comp>
+size_t mapped_binomial_heap<T, Comp>::image_size() const { return image_count; }
+
+/**
+ *  @brief  Returns whether or not the heap is empty
+ *  @return true if neither the image nor the overlay holds a key. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool mapped_binomial_heap<T, Comp>::empty() const { return !size(); }
+
+/**
+ *  @brief  Returns whether the minimum key of the heap lives in the image. Ties go to the image.
+ *  @return true if the image holds the minimum key. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool mapped_binomial_heap<T, Comp>::image_first() const {
+    if(image.empty()) return false;
+    return overlay.empty() || !compare(overlay.top(), keys[image.top().index]);
+}
+
+/**
+ *  @brief  Gets the minimum key. O(1) time.
+ *  @return the minimum key, by reference
+ */
+template<typename T, typename Comp>
+const T& mapped_binomial_heap<T, Comp>::top() const {
+    if(empty()) throw std::out_of_range("Empty");
+    return image_first() ? keys[image.top().index] : overlay.top();
+}
+
+/**
+ *  @brief  Gets the minimum key. O(1) time.
+ *  @return a copy of the minimum key
+ */
+template<typename T, typename Comp>
+T mapped_binomial_heap<T, Comp>::min() const { return top(); }
+
+/**
+ *  @brief  Removes the minimum key. An image key is removed by replacing its subtree with the
+ *          subtrees of its children, leaving the mapping untouched. O(log n) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T mapped_binomial_heap<T, Comp>::extract() {
+    if(empty()) throw std::out_of_range("Empty");
+    if(!image_first()) return overlay.extract();
+    subtree root = image.extract();
+    uint64_t child = root.index + 1;
+    for(unsigned degree = root.degree; degree--; child += uint64_t(1) << degree)
+        image.insert(subtree{child, static_cast<unsigned char>(degree)});
+    --image_count;
+    return keys[root.index];
+}
+
+/**
+ *  @brief  Removes the minimum key. O(log n) time.
+ *  @return the removed key
+ */
+template<typename T, typename Comp>
+T mapped_binomial_heap<T, Comp>::pop() { return extract(); }
+
+/**
+ *  @brief      Inserts a key into the overlay. O(1) am. time.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void mapped_binomial_heap<T, Comp>::insert(const T& key) { overlay.insert(key); }
+
+/**
+ *  @brief      Inserts a key into the overlay. O(1) am. time.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void mapped_binomial_heap<T, Comp>::insert(T&& key) { overlay.insert(std::move(key)); }
+
+/**
+ *  @brief      Constructs a key in place in the overlay. O(1) am. time.
+ *  @param[in]  args the arguments to be forwarded to the constructor of T
+ */
+template<typename T, typename Comp>
+template<class...Args>
+void mapped_binomial_heap<T, Comp>::emplace(Args&&...args) {
+    overlay.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ *  @brief      Finds a key in the heap. Image subtrees whose root is greater than the key are
+ *              skipped. Throws std::out_of_range if the key is not found. O(n) time.
+ *  @param[in]  key the key to be found
+ *  @return     the key in the heap, by reference
+ */
+template<typename T, typename Comp>
+const T& mapped_binomial_heap<T, Comp>::find(const T& key) const {
+    const T* found = nullptr;
+    image.for_each([&](const subtree& root) { if(!found) found = search(root, key); });
+    if(found) return *found;
+    return *overlay.find(key);
+}
+
+/**
+ *  @brief      Calls a visitor on every key in the heap, in no particular order. O(n) time.
+ *  @param[in]  visit the function to be called with each key, by const reference
+ */
+template<typename T, typename Comp>
+template<class Visitor>
+void mapped_binomial_heap<T, Comp>::for_each(Visitor visit) const {
+    image.for_each([&](const subtree& root) { visit_subtree(root, visit); });
+    overlay.for_each(std::ref(visit));
+}
+
+/**
+ *  @brief      Searches an image subtree for a key, skipping subtrees that heap-ordering rules out
+ *  @param[in]  root the subtree to be searched
+ *  @param[in]  key the key to be found
+ *  @return     a pointer to the key in the image, or nullptr if the subtree does not hold it
+ */
+template<typename T, typename Comp>
+const T* mapped_binomial_heap<T, Comp>::search(const subtree& root, const T& key) const {
+    const T& candidate = keys[root.index];
+    if(compare(key, candidate)) return nullptr;
+    if(!compare(candidate, key)) return &candidate;
+    uint64_t child = root.index + 1;
+    for(unsigned degree = root.degree; degree--; child += uint64_t(1) << degree) {
+        const T* found = search(subtree{child, static_cast<unsigned char>(degree)}, key);
+        if(found) return found;
+    }
+    return nullptr;
+}
+
+/**
+ *  @brief      Calls a visitor on every key of an image subtree, in preorder. A whole subtree is
+ *              one contiguous run of the image, so this is a linear scan.
+ *  @param[in]  root the subtree to be visited
+ *  @param[in]  visit the function to be called with each key
+ */
+template<typename T, typename Comp>
+template<class Visitor>
+void mapped_binomial_heap<T, Comp>::visit_subtree(const subtree& root, Visitor& visit) const {
+    const T* end = keys + root.index + (uint64_t(1) << root.degree);
+    for(const T* key = keys + root.index; key != end; ++key) visit(*key);
+}
+#endif
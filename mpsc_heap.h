@@ -0,0 +1,309 @@
+/**
+ *  @file   mpsc_heap.h
+ *  @brief  A binomial_heap fronted by a lock-free insertion buffer, for many producer threads
+ *          feeding a single consumer thread.
+ * 
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef MPSC_HEAP
+#define MPSC_HEAP 1
+#include <atomic>
+#include "binomial_heap.h"
+
+/**
+ *  @brief  A multi-producer, single-consumer heap. Producers publish keys onto a lock-free stack
+ *          with a single compare-and-swap. Before every consumer operation the whole stack is
+ *          taken with one exchange and merged into the heap with one bulk build.
+ *  @tparam T the type of the key that wil be stored in the heap
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class mpsc_heap {
+public:
+    explicit mpsc_heap(const Comp& compare = Comp());
+    mpsc_heap(const mpsc_heap&) = delete;
+    mpsc_heap& operator=(const mpsc_heap&) = delete;
+    ~mpsc_heap();
+    void push(const T& key);
+    void push(T&& key);
+    template<class...Args> void emplace(Args&&...args);
+    size_t size();
+    bool empty();
+    const T& top();
+    T pop();
+    std::optional<T> try_pop();
+    binomial_heap<T, Comp>& heap();
+    size_t drain();
+private:
+    struct cell {
+        template<class...Args> explicit cell(Args&&...args);
+        T key;
+        cell* next;
+    };
+    class batch_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+        explicit batch_iterator(cell* current);
+        T& operator*() const;
+        batch_iterator& operator++();
+        bool operator==(const batch_iterator& rhs) const;
+        bool operator!=(const batch_iterator& rhs) const;
+    private:
+        cell* current;
+    };
+    static void free_batch(cell* batch);
+    void publish(cell* first, cell* last);
+    std::atomic<cell*> head;
+    binomial_heap<T, Comp> _heap;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               mpsc_heap helper class implementations                             *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructs a buffered key in place
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
+ */
+template<typename T, typename Comp>
+template<class...Args>
+mpsc_heap<T, Comp>::cell::cell(Args&&...args) : key(std::forward<Args>(args)...), next(nullptr) {}
+
+/**
+ *  @brief      Constructor for iterators over a drained batch
+ *  @param[in]  current the first cell of the batch, or nullptr for the end of the batch
+ */
+template<typename T, typename Comp>
+mpsc_heap<T, Comp>::batch_iterator::batch_iterator(typename mpsc_heap<T, Comp>::cell* current) :
+    current(current) {}
+
+/**
+ *  @brief  Dereference operator for batch iterators
+ *  @return the key of the current cell, by reference
+ */
+template<typename T, typename Comp>
+T& mpsc_heap<T, Comp>::batch_iterator::operator*() const { return current->key; }
+
+/**
+ *  @brief  Advances to the next cell of the batch
+ *  @return this iterator by reference
+ */
+template<typename T, typename Comp>
+typename mpsc_heap<T, Comp>::batch_iterator& mpsc_heap<T, Comp>::batch_iterator::operator++() {
+    current = current->next;
+    return *this;
+}
+
+/**
+ *  @brief      Equality operator for batch iterators
+ *  @param[in]  rhs the iterator to be compared with
+ *  @return     true if both iterators are at the same cell. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool mpsc_heap<T, Comp>::batch_iterator::operator==(
+    const typename mpsc_heap<T, Comp>::batch_iterator& rhs
+) const { return current == rhs.current; }
+
+/**
+ *  @brief      Inequality operator for batch iterators
+ *  @param[in]  rhs the iterator to be compared with
+ *  @return     false if both iterators are at the same cell. Otherwise, true
+ */
+template<typename T, typename Comp>
+bool mpsc_heap<T, Comp>::batch_iterator::operator!=(
+    const typename mpsc_heap<T, Comp>::batch_iterator& rhs
+) const { return current != rhs.current; }
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                     mpsc_heap implementation                                     *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Default constructor for the mpsc_heap class
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+mpsc_heap<T, Comp>::mpsc_heap(const Comp& compare) : head(nullptr), _heap(compare) {}
+
+/**
+ *  @brief  Destructor for the mpsc_heap class. No producer may still be pushing.
+ */
+template<typename T, typename Comp>
+mpsc_heap<T, Comp>::~mpsc_heap() { free_batch(head.exchange(nullptr, std::memory_order_acquire)); }
+
+/**
+ *  @brief      Publishes a key for the consumer. Safe to call from any thread; lock-free.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void mpsc_heap<T, Comp>::push(const T& key) {
+    cell* published = new cell(key);
+    publish(published, published);
+}
+
+/**
+ *  @brief      Publishes a key for the consumer. Safe to call from any thread; lock-free.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void mpsc_heap<T, Comp>::push(T&& key) {
+    cell* published = new cell(std::move(key));
+    publish(published, published);
+}
+
+/**
+ *  @brief      Publishes a key constructed from args for the consumer. Safe to call from any
+ *              thread; lock-free.
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
+ */
+template<typename T, typename Comp>
+template<class...Args>
+void mpsc_heap<T, Comp>::emplace(Args&&...args) {
+    cell* published = new cell(std::forward<Args>(args)...);
+    publish(published, published);
+}
+
+/**
+ *  @brief  Gets the number of elements, including every key published so far. Consumer only.
+ *  @return the number of elements in the heap
+ */
+template<typename T, typename Comp>
+size_t mpsc_heap<T, Comp>::size() {
+    drain();
+    return _heap.size();
+}
+
+/**
+ *  @brief  Returns whether or not the heap is empty, counting every key published so far.
+ *          Consumer only.
+ *  @return true if the heap has zero elements. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool mpsc_heap<T, Comp>::empty() {
+    drain();
+    return _heap.empty();
+}
+
+/**
+ *  @brief  Gets the minimum element, counting every key published so far. Consumer only.
+ *  @return a reference to the minimum element
+ */
+template<typename T, typename Comp>
+const T& mpsc_heap<T, Comp>::top() {
+    drain();
+    return _heap.top();
+}
+
+/**
+ *  @brief  Extracts the minimum element, counting every key published so far. Consumer only.
+ *  @return the minimum element, moved out of the heap
+ */
+template<typename T, typename Comp>
+T mpsc_heap<T, Comp>::pop() {
+    drain();
+    return _heap.pop();
+}
+
+/**
+ *  @brief  Extracts the minimum element if there is one, counting every key published so far.
+ *          Consumer only.
+ *  @return the minimum element, or std::nullopt if the heap is empty
+ */
+template<typename T, typename Comp>
+std::optional<T> mpsc_heap<T, Comp>::try_pop() {
+    drain();
+    return _heap.try_extract();
+}
+
+/**
+ *  @brief  Gives the consumer direct access to the heap after draining the buffer, for
+ *          operations that mpsc_heap does not forward. Consumer only.
+ *  @return the underlying heap, by reference
+ */
+template<typename T, typename Comp>
+binomial_heap<T, Comp>& mpsc_heap<T, Comp>::heap() {
+    drain();
+    return _heap;
+}
+
+/**
+ *  @brief  Takes every published key with one atomic exchange and inserts them into the heap
+ *          with one bulk build and one merge. The build reuses nodes freed by earlier pops, so
+ *          steady push/pop traffic does not grow the heap's pool. Keys are moved out of the batch
+ *          if that cannot throw and copied otherwise, so if the build throws, the whole batch is
+ *          published again before the exception propagates and no key is lost. Only a key type
+ *          that can neither be copied nor moved without throwing may lose keys of a failed
+ *          batch. Consumer only. Linear in the size of the batch.
+ *  @return the number of keys that were drained
+ */
+template<typename T, typename Comp>
+size_t mpsc_heap<T, Comp>::drain() {
+    cell* batch = head.exchange(nullptr, std::memory_order_acquire);
+    if(!batch) return 0;
+    size_t before = _heap.size();
+    try {
+        if constexpr(
+            std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value
+        ) {
+            _heap.multi_insert(
+                std::make_move_iterator(batch_iterator(batch)),
+                std::make_move_iterator(batch_iterator(nullptr))
+            );
+        } else {
+            _heap.multi_insert(batch_iterator(batch), batch_iterator(nullptr));
+        }
+    } catch(...) {
+        cell* last = batch;
+        while(last->next) last = last->next;
+        publish(batch, last);
+        throw;
+    }
+    free_batch(batch);
+    return _heap.size() - before;
+}
+
+/**
+ *  @brief      Deletes every cell of a batch
+ *  @param[in]  batch the first cell of the batch
+ */
+template<typename T, typename Comp>
+void mpsc_heap<T, Comp>::free_batch(typename mpsc_heap<T, Comp>::cell* batch) {
+    while(batch) {
+        cell* next = batch->next;
+        delete batch;
+        batch = next;
+    }
+}
+
+/**
+ *  @brief      Pushes a chain of cells onto the lock-free stack with a compare-and-swap loop, which
+ *              succeeds on the first attempt unless another producer pushed at the same moment
+ *  @param[in]  first the first cell of the chain
+ *  @param[in]  last the last cell of the chain, which is first itself for a single cell
+ */
+template<typename T, typename Comp>
+void mpsc_heap<T, Comp>::publish(
+    typename mpsc_heap<T, Comp>::cell* first,
+    typename mpsc_heap<T, Comp>::cell* last
+) {
+    last->next = head.load(std::memory_order_relaxed);
+    while(!head.compare_exchange_weak(
+        last->next,
+        first,
+        std::memory_order_release,
+        std::memory_order_relaxed
+    )) {}
+}
+#endif
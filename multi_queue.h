@@ -0,0 +1,328 @@
+/**
+ *  @file   multi_queue.h
+ *  @brief  A relaxed concurrent priority queue (MultiQueue) that spreads its elements over many
+ *          binomial_heap shards, each behind its own lock.
+ * 
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef MULTI_QUEUE
+#define MULTI_QUEUE 1
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "binomial_heap.h"
+
+/**
+ *  @brief  A concurrent priority queue with relaxed ordering. Inserts go to a random shard, and
+ *          pops take the better of the minimums of two random shards, so pop() returns an element
+ *          close to, but not always exactly, the global minimum.
+ *  @tparam T the type of the key that wil be stored in the queue
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class multi_queue {
+public:
+    struct statistics {
+        uint64_t pushes;
+        uint64_t pops;
+        uint64_t lock_retries;
+        uint64_t empty_probes;
+        uint64_t rank_samples;
+        uint64_t rank_error_sum;
+        uint64_t rank_error_max;
+    };
+    explicit multi_queue(
+        size_t threads = std::thread::hardware_concurrency(),
+        size_t shards_per_thread = 2,
+        const Comp& compare = Comp()
+    );
+    multi_queue(const multi_queue&) = delete;
+    multi_queue& operator=(const multi_queue&) = delete;
+    size_t size() const;
+    bool empty() const;
+    size_t shard_count() const;
+    void push(const T& key);
+    void push(T&& key);
+    template<class...Args> void emplace(Args&&...args);
+    std::optional<T> try_pop();
+    void sample_rank_error(uint64_t interval);
+    statistics stats() const;
+private:
+    struct alignas(64) shard {
+        explicit shard(const Comp& compare);
+        std::mutex lock;
+        binomial_heap<T, Comp> heap;
+        uint64_t pushes;
+        uint64_t pops;
+    };
+    static std::minstd_rand& generator();
+    size_t random_shard();
+    shard& lock_random_shard();
+    std::optional<T> pop_any();
+    void record_rank_error(const T& popped);
+    Comp compare;
+    size_t count;
+    std::unique_ptr<std::unique_ptr<shard>[]> shards;
+    std::atomic<size_t> _size;
+    std::atomic<uint64_t> lock_retries;
+    std::atomic<uint64_t> empty_probes;
+    std::atomic<uint64_t> sample_interval;
+    std::atomic<uint64_t> sample_clock;
+    std::atomic<uint64_t> rank_samples;
+    std::atomic<uint64_t> rank_error_sum;
+    std::atomic<uint64_t> rank_error_max;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                multi_queue::shard implementation                                 *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructor for shards
+ *  @param[in]  compare the comparison functor for the shard's heap
+ */
+template<typename T, typename Comp>
+multi_queue<T, Comp>::shard::shard(const Comp& compare) : heap(compare), pushes(0), pops(0) {}
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                    multi_queue implementation                                    *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructor for the multi_queue class. Keeps threads * shards_per_thread shards,
+ *              and at least two.
+ *  @param[in]  threads the number of threads expected to use the queue, defaults to the number of
+ *              hardware threads
+ *  @param[in]  shards_per_thread the number of shards per thread, defaults to 2
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+multi_queue<T, Comp>::multi_queue(size_t threads, size_t shards_per_thread, const Comp& compare) :
+    compare(compare),
+    count(std::max<size_t>(2, std::max<size_t>(1, threads) * shards_per_thread)),
+    shards(new std::unique_ptr<shard>[count]),
+    _size(0),
+    lock_retries(0),
+    empty_probes(0),
+    sample_interval(0),
+    sample_clock(0),
+    rank_samples(0),
+    rank_error_sum(0),
+    rank_error_max(0) {
+    for(size_t i = 0; i < count; ++i) shards[i].reset(new shard(compare));
+}
+
+/**
+ *  @brief  Gets the number of elements in the queue. Exact only while no other thread is pushing
+ *          or popping.
+ *  @return the number of elements in the queue
+ */
+template<typename T, typename Comp>
+size_t multi_queue<T, Comp>::size() const { return _size.load(std::memory_order_relaxed); }
+
+/**
+ *  @brief  Returns whether or not the queue is empty. Exact only while no other thread is pushing
+ *          or popping.
+ *  @return true if the queue has zero elements. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool multi_queue<T, Comp>::empty() const { return !size(); }
+
+/**
+ *  @brief  Gets the number of shards
+ *  @return the number of binomial_heap shards in the queue
+ */
+template<typename T, typename Comp>
+size_t multi_queue<T, Comp>::shard_count() const { return count; }
+
+/**
+ *  @brief      Inserts a key into a random shard. O(1) am. time plus lock acquisition.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void multi_queue<T, Comp>::push(const T& key) { emplace(key); }
+
+/**
+ *  @brief      Inserts a key into a random shard. O(1) am. time plus lock acquisition.
+ *  @param[in]  key the key to be inserted
+ */
+template<typename T, typename Comp>
+void multi_queue<T, Comp>::push(T&& key) { emplace(std::move(key)); }
+
+/**
+ *  @brief      Emplaces a key into a random shard. O(1) am. time plus lock acquisition.
+ *  @param[in]  ...args parameter list for the constructor for T, perfectly forwarded
+ */
+template<typename T, typename Comp>
+template<class...Args>
+void multi_queue<T, Comp>::emplace(Args&&...args) {
+    shard& target = lock_random_shard();
+    std::lock_guard<std::mutex> guard(target.lock, std::adopt_lock);
+    target.heap.emplace(std::forward<Args>(args)...);
+    ++target.pushes;
+    _size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  @brief  Pops the better of the minimums of two random shards. Falls back to a sweep over every
+ *          shard after repeatedly finding empty shards, so an element is always returned when the
+ *          queue is not empty and no other thread is popping.
+ *  @return the popped element, or std::nullopt if every shard was empty
+ */
+template<typename T, typename Comp>
+std::optional<T> multi_queue<T, Comp>::try_pop() {
+    for(size_t misses = 0; misses < count;) {
+        size_t first = random_shard();
+        size_t second = random_shard();
+        if(first == second) second = (second + 1) % count;
+        shard& lhs = *shards[first];
+        shard& rhs = *shards[second];
+        std::optional<T> popped;
+        {
+            if(!lhs.lock.try_lock()) {
+                lock_retries.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::lock_guard<std::mutex> lhs_guard(lhs.lock, std::adopt_lock);
+            if(!rhs.lock.try_lock()) {
+                lock_retries.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::lock_guard<std::mutex> rhs_guard(rhs.lock, std::adopt_lock);
+            shard* best = nullptr;
+            if(!lhs.heap.empty()) best = &lhs;
+            if(!rhs.heap.empty() && (!best || compare(rhs.heap.top(), best->heap.top())))
+                best = &rhs;
+            if(!best) {
+                empty_probes.fetch_add(1, std::memory_order_relaxed);
+                ++misses;
+                continue;
+            }
+            popped.emplace(best->heap.pop());
+            ++best->pops;
+            _size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        record_rank_error(*popped);
+        return popped;
+    }
+    return pop_any();
+}
+
+/**
+ *  @brief      Turns on sampling of the rank error. Every interval-th pop counts how many shards
+ *              have a minimum better than the popped element, which is a lower bound on the number
+ *              of elements that should have come out first. 0 turns sampling off.
+ *  @param[in]  interval the number of pops between samples
+ */
+template<typename T, typename Comp>
+void multi_queue<T, Comp>::sample_rank_error(uint64_t interval) {
+    sample_interval.store(interval, std::memory_order_relaxed);
+}
+
+/**
+ *  @brief  Gathers the queue's counters. Only exact while no other thread is using the queue.
+ *  @return the push, pop, contention and rank error counters of the queue
+ */
+template<typename T, typename Comp>
+typename multi_queue<T, Comp>::statistics multi_queue<T, Comp>::stats() const {
+    statistics result{};
+    for(size_t i = 0; i < count; ++i) {
+        std::lock_guard<std::mutex> guard(shards[i]->lock);
+        result.pushes += shards[i]->pushes;
+        result.pops += shards[i]->pops;
+    }
+    result.lock_retries = lock_retries.load(std::memory_order_relaxed);
+    result.empty_probes = empty_probes.load(std::memory_order_relaxed);
+    result.rank_samples = rank_samples.load(std::memory_order_relaxed);
+    result.rank_error_sum = rank_error_sum.load(std::memory_order_relaxed);
+    result.rank_error_max = rank_error_max.load(std::memory_order_relaxed);
+    return result;
+}
+
+/**
+ *  @brief  Gets this thread's random number generator, seeded once per thread
+ *  @return the generator, by reference
+ */
+template<typename T, typename Comp>
+std::minstd_rand& multi_queue<T, Comp>::generator() {
+    static thread_local std::minstd_rand engine(
+        std::random_device{}() ^ uint32_t(std::hash<std::thread::id>{}(std::this_thread::get_id()))
+    );
+    return engine;
+}
+
+/**
+ *  @brief  Picks a shard uniformly at random
+ *  @return the index of the shard
+ */
+template<typename T, typename Comp>
+size_t multi_queue<T, Comp>::random_shard() { return generator()() % count; }
+
+/**
+ *  @brief  Try-locks random shards until one is acquired
+ *  @return the locked shard, which the caller must unlock
+ */
+template<typename T, typename Comp>
+typename multi_queue<T, Comp>::shard& multi_queue<T, Comp>::lock_random_shard() {
+    for(;;) {
+        shard& target = *shards[random_shard()];
+        if(target.lock.try_lock()) return target;
+        lock_retries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ *  @brief  Locks every shard in turn and pops from the first one that is not empty. The pop is
+ *          sampled for rank error like any other, once the shard is unlocked.
+ *  @return the popped element, or std::nullopt if every shard was empty
+ */
+template<typename T, typename Comp>
+std::optional<T> multi_queue<T, Comp>::pop_any() {
+    size_t start = random_shard();
+    for(size_t i = 0; i < count; ++i) {
+        shard& target = *shards[(start + i) % count];
+        std::optional<T> popped;
+        {
+            std::lock_guard<std::mutex> guard(target.lock);
+            if(target.heap.empty()) continue;
+            popped.emplace(target.heap.pop());
+            ++target.pops;
+            _size.fetch_sub(1, std::memory_order_relaxed);
+        }
+        record_rank_error(*popped);
+        return popped;
+    }
+    return std::nullopt;
+}
+
+/**
+ *  @brief      Samples the rank error of a popped element if it is time to. Shards that are busy
+ *              are skipped, so a sample never blocks. The caller must not hold any shard's lock.
+ *  @param[in]  popped the element that was just popped
+ */
+template<typename T, typename Comp>
+void multi_queue<T, Comp>::record_rank_error(const T& popped) {
+    uint64_t interval = sample_interval.load(std::memory_order_relaxed);
+    if(!interval || (sample_clock.fetch_add(1, std::memory_order_relaxed) + 1) % interval) return;
+    uint64_t error = 0;
+    for(size_t i = 0; i < count; ++i) {
+        shard& target = *shards[i];
+        if(!target.lock.try_lock()) continue;
+        std::lock_guard<std::mutex> guard(target.lock, std::adopt_lock);
+        if(!target.heap.empty() && compare(target.heap.top(), popped)) ++error;
+    }
+    rank_samples.fetch_add(1, std::memory_order_relaxed);
+    rank_error_sum.fetch_add(error, std::memory_order_relaxed);
+    uint64_t seen = rank_error_max.load(std::memory_order_relaxed);
+    while(seen < error && !rank_error_max.compare_exchange_weak(seen, error)) {}
+}
+#endif
@@ -0,0 +1,239 @@
+/**
+ *  @file   persistent_heap.h
+ *  @brief  An immutable binomial heap whose operations return new versions that share every
+ *          unchanged subtree with the version they were made from.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef PERSISTENT_HEAP
+#define PERSISTENT_HEAP 1
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "root_scan.h"
+
+/**
+ *  @brief  A persistent binomial heap. A version is never modified: insert(), merge() and pop()
+ *          return a new version in O(log n) time, linking at most O(log n) new nodes onto subtrees
+ *          shared with the old one through reference counts. Keeping a version around costs
+ *          nothing until it is changed, so speculative work can branch off any version and drop
+ *          it without a deep copy. Versions may be read from and branched on by several threads.
+ *  @tparam T the type of the keys
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename T, typename Comp = std::less<T>>
+class persistent_binomial_heap {
+public:
+    explicit persistent_binomial_heap(const Comp& compare = Comp());
+    size_t size() const;
+    bool empty() const;
+    const T& top() const;
+    T min() const;
+    persistent_binomial_heap insert(const T& key) const;
+    persistent_binomial_heap insert(T&& key) const;
+    persistent_binomial_heap merge(const persistent_binomial_heap& rhs) const;
+    persistent_binomial_heap pop() const;
+private:
+    struct tree;
+    struct cell;
+    using tree_ptr = std::shared_ptr<const tree>;
+    using list_ptr = std::shared_ptr<const cell>;
+    static constexpr size_t max_degree = 64;
+    struct tree {
+        T key;
+        unsigned char degree;
+        list_ptr children;
+    };
+    struct cell {
+        tree_ptr head;
+        list_ptr tail;
+    };
+    struct forest {
+        tree_ptr trees[max_degree];
+        uint64_t mask = 0;
+    };
+    void gather(forest& into, const list_ptr& list, const tree* skip = nullptr) const;
+    void add_tree(forest& into, tree_ptr added) const;
+    persistent_binomial_heap with_forest(forest& from, size_t size) const;
+    Comp compare;
+    list_ptr roots;
+    tree_ptr _min;
+    size_t _size;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                            persistent_binomial_heap implementation                               *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Constructs an empty heap
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp>::persistent_binomial_heap(const Comp& compare) :
+    compare(compare),
+    roots(),
+    _min(),
+    _size(0) {}
+
+/**
+ *  @brief  Gets the number of keys in this version
+ *  @return the number of keys in this version
+ */
+template<typename T, typename Comp>
+size_t persistent_binomial_heap<T, Comp>::size() const { return _size; }
+
+/**
+ *  @brief  Returns whether or not this version is empty
+ *  @return true if this version holds no keys. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool persistent_binomial_heap<T, Comp>::empty() const { return !_size; }
+
+/**
+ *  @brief  Gets the minimum key. O(1) time.
+ *  @return the minimum key, by reference. It lives as long as any version that holds it.
+ */
+template<typename T, typename Comp>
+const T& persistent_binomial_heap<T, Comp>::top() const {
+    if(!_min) throw std::out_of_range("Empty");
+    return _min->key;
+}
+
+/**
+ *  @brief  Gets the minimum key. O(1) time.
+ *  @return a copy of the minimum key
+ */
+template<typename T, typename Comp>
+T persistent_binomial_heap<T, Comp>::min() const { return top(); }
+
+/**
+ *  @brief      Makes a version with one more key. This version is left unchanged. O(log n) time.
+ *  @param[in]  key the key to be inserted
+ *  @return     the new version
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp> persistent_binomial_heap<T, Comp>::insert(const T& key) const {
+    return insert(T(key));
+}
+
+/**
+ *  @brief      Makes a version with one more key. This version is left unchanged. O(log n) time.
+ *  @param[in]  key the key to be inserted
+ *  @return     the new version
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp> persistent_binomial_heap<T, Comp>::insert(T&& key) const {
+    forest result;
+    gather(result, roots);
+    add_tree(result, std::make_shared<const tree>(tree{std::move(key), 0, nullptr}));
+    return with_forest(result, _size + 1);
+}
+
+/**
+ *  @brief      Makes a version holding the keys of both this version and rhs. Neither is changed,
+ *              and the trees of both are shared rather than copied. O(log n) time.
+ *  @param[in]  rhs the version to be merged with this one
+ *  @return     the new version
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp> persistent_binomial_heap<T, Comp>::merge(
+    const persistent_binomial_heap<T, Comp>& rhs
+) const {
+    forest result;
+    gather(result, roots);
+    for(const cell* walker = rhs.roots.get(); walker; walker = walker->tail.get())
+        add_tree(result, walker->head);
+    return with_forest(result, _size + rhs._size);
+}
+
+/**
+ *  @brief  Makes a version without the minimum key. This version is left unchanged. O(log n) time.
+ *  @return the new version
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp> persistent_binomial_heap<T, Comp>::pop() const {
+    if(!_min) throw std::out_of_range("Empty");
+    forest result;
+    gather(result, roots, _min.get());
+    for(const cell* walker = _min->children.get(); walker; walker = walker->tail.get())
+        add_tree(result, walker->head);
+    return with_forest(result, _size - 1);
+}
+
+/**
+ *  @brief          Places the trees of a root list into a forest indexed by degree. The trees of
+ *                  one version all have different degrees, so nothing is linked.
+ *  @param[in, out] into the forest the trees are to be placed in
+ *  @param[in]      list the root list whose trees are to be placed
+ *  @param[in]      skip a tree to be left out, if any
+ */
+template<typename T, typename Comp>
+void persistent_binomial_heap<T, Comp>::gather(
+    typename persistent_binomial_heap<T, Comp>::forest& into,
+    const typename persistent_binomial_heap<T, Comp>::list_ptr& list,
+    const typename persistent_binomial_heap<T, Comp>::tree* skip
+) const {
+    for(const cell* walker = list.get(); walker; walker = walker->tail.get()) {
+        if(walker->head.get() == skip) continue;
+        into.trees[walker->head->degree] = walker->head;
+        into.mask |= uint64_t(1) << walker->head->degree;
+    }
+}
+
+/**
+ *  @brief          Adds a tree to a forest, carrying into higher degrees as binary addition does.
+ *                  Each link makes one new root whose children list starts with the other tree and
+ *                  then shares the old root's children.
+ *  @param[in, out] into the forest the tree is to be added to
+ *  @param[in]      added the tree to be added
+ */
+template<typename T, typename Comp>
+void persistent_binomial_heap<T, Comp>::add_tree(
+    typename persistent_binomial_heap<T, Comp>::forest& into,
+    typename persistent_binomial_heap<T, Comp>::tree_ptr added
+) const {
+    size_t degree = added->degree;
+    for(; into.mask & (uint64_t(1) << degree); ++degree) {
+        into.mask &= ~(uint64_t(1) << degree);
+        tree_ptr other = std::move(into.trees[degree]);
+        if(compare(other->key, added->key)) std::swap(other, added);
+        list_ptr children = std::make_shared<const cell>(cell{std::move(other), added->children});
+        added = std::make_shared<const tree>(
+            tree{added->key, static_cast<unsigned char>(degree + 1), std::move(children)}
+        );
+    }
+    into.trees[degree] = std::move(added);
+    into.mask |= uint64_t(1) << degree;
+}
+
+/**
+ *  @brief          Makes a version from a forest, listing its roots and finding the minimum
+ *                  among them
+ *  @param[in, out] from the forest whose trees are to be taken
+ *  @param[in]      size the number of keys in the forest
+ *  @return         the new version
+ */
+template<typename T, typename Comp>
+persistent_binomial_heap<T, Comp> persistent_binomial_heap<T, Comp>::with_forest(
+    typename persistent_binomial_heap<T, Comp>::forest& from,
+    size_t size
+) const {
+    persistent_binomial_heap result(compare);
+    result._size = size;
+    for(uint64_t mask = from.mask; mask; mask &= mask - 1) {
+        tree_ptr& root = from.trees[lowest_set_bit(mask)];
+        if(!result._min || compare(root->key, result._min->key)) result._min = root;
+        result.roots = std::make_shared<const cell>(cell{std::move(root), std::move(result.roots)});
+    }
+    return result;
+}
+#endif
@@ -0,0 +1,434 @@
+/**
+ *  @file   root_scan.h
+ *  @brief  A contiguous mirror of the root keys of a binomial_heap, letting arithmetic keys
+ *          ordered by std::less or std::greater find their minimum root with SIMD instructions.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef ROOT_SCAN
+#define ROOT_SCAN 1
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+/**
+ *  @brief      Index of the lowest set bit of a mask
+ *  @param[in]  mask a nonzero bitmask
+ *  @return     the number of trailing zero bits in mask
+ */
+inline unsigned lowest_set_bit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return index;
+#else
+    unsigned index = 0;
+    for(; !(mask & 1); mask >>= 1) ++index;
+    return index;
+#endif
+}
+
+/**
+ *  @brief  Tells which way a comparator orders keys, if it is one the root scan understands
+ *  @tparam T the type of the keys
+ *  @tparam Comp the comparison function of the heap
+ */
+template<typename T, typename Comp>
+struct root_scan_order {
+    static constexpr bool ascending =
+        std::is_same<Comp, std::less<T>>::value || std::is_same<Comp, std::less<>>::value;
+    static constexpr bool descending =
+        std::is_same<Comp, std::greater<T>>::value || std::is_same<Comp, std::greater<>>::value;
+    static constexpr bool enabled = std::is_arithmetic<T>::value && (ascending || descending);
+};
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                         SIMD lane operations                                     *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief  The vector operations the root scan needs for one key type on one instruction set.
+ *          The primary template marks key types that have no vector kernel; they use the scalar
+ *          scan over the mirrored keys instead.
+ *  @tparam T the type of the keys
+ */
+template<typename T, typename = void>
+struct root_scan_lanes {
+    static constexpr bool vectorized = false;
+};
+
+#if defined(__AVX2__)
+/**
+ *  @brief  AVX2 operations for 32-bit integers, eight lanes at a time
+ */
+template<typename T>
+struct root_scan_lanes<T, typename std::enable_if<
+    std::is_integral<T>::value && sizeof(T) == 4
+>::type> {
+    using vector = __m256i;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 8;
+    static vector load(const T* keys) {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(keys));
+    }
+    static vector fill(T key) { return _mm256_set1_epi32(int32_t(key)); }
+    static vector select(unsigned bits) {
+        const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        __m256i picked = _mm256_and_si256(_mm256_set1_epi32(int32_t(bits)), lane_bits);
+        return _mm256_cmpeq_epi32(picked, lane_bits);
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm256_blendv_epi8(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) {
+        if constexpr(std::is_signed<T>::value) return _mm256_min_epi32(lhs, rhs);
+        else return _mm256_min_epu32(lhs, rhs);
+    }
+    static vector higher(vector lhs, vector rhs) {
+        if constexpr(std::is_signed<T>::value) return _mm256_max_epi32(lhs, rhs);
+        else return _mm256_max_epu32(lhs, rhs);
+    }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+    }
+    static void store(T* out, vector keys) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), keys);
+    }
+};
+
+/**
+ *  @brief  AVX2 operations for signed 64-bit integers, four lanes at a time
+ */
+template<typename T>
+struct root_scan_lanes<T, typename std::enable_if<
+    std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8
+>::type> {
+    using vector = __m256i;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 4;
+    static vector load(const T* keys) {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(keys));
+    }
+    static vector fill(T key) { return _mm256_set1_epi64x(int64_t(key)); }
+    static vector select(unsigned bits) {
+        const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+        __m256i picked = _mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits);
+        return _mm256_cmpeq_epi64(picked, lane_bits);
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm256_blendv_epi8(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) {
+        return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs));
+    }
+    static vector higher(vector lhs, vector rhs) {
+        return _mm256_blendv_epi8(rhs, lhs, _mm256_cmpgt_epi64(lhs, rhs));
+    }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)));
+    }
+    static void store(T* out, vector keys) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), keys);
+    }
+};
+
+/**
+ *  @brief  AVX2 operations for floats, eight lanes at a time
+ */
+template<>
+struct root_scan_lanes<float> {
+    using vector = __m256;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 8;
+    static vector load(const float* keys) { return _mm256_load_ps(keys); }
+    static vector fill(float key) { return _mm256_set1_ps(key); }
+    static vector select(unsigned bits) {
+        const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        __m256i picked = _mm256_and_si256(_mm256_set1_epi32(int32_t(bits)), lane_bits);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(picked, lane_bits));
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm256_blendv_ps(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) { return _mm256_min_ps(lhs, rhs); }
+    static vector higher(vector lhs, vector rhs) { return _mm256_max_ps(lhs, rhs); }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ));
+    }
+    static void store(float* out, vector keys) { _mm256_storeu_ps(out, keys); }
+};
+
+/**
+ *  @brief  AVX2 operations for doubles, four lanes at a time
+ */
+template<>
+struct root_scan_lanes<double> {
+    using vector = __m256d;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 4;
+    static vector load(const double* keys) { return _mm256_load_pd(keys); }
+    static vector fill(double key) { return _mm256_set1_pd(key); }
+    static vector select(unsigned bits) {
+        const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+        __m256i picked = _mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits);
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(picked, lane_bits));
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm256_blendv_pd(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) { return _mm256_min_pd(lhs, rhs); }
+    static vector higher(vector lhs, vector rhs) { return _mm256_max_pd(lhs, rhs); }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ));
+    }
+    static void store(double* out, vector keys) { _mm256_storeu_pd(out, keys); }
+};
+#elif defined(__SSE4_1__)
+/**
+ *  @brief  SSE4.1 operations for 32-bit integers, four lanes at a time
+ */
+template<typename T>
+struct root_scan_lanes<T, typename std::enable_if<
+    std::is_integral<T>::value && sizeof(T) == 4
+>::type> {
+    using vector = __m128i;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 4;
+    static vector load(const T* keys) {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(keys));
+    }
+    static vector fill(T key) { return _mm_set1_epi32(int32_t(key)); }
+    static vector select(unsigned bits) {
+        const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+        return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(int32_t(bits)), lane_bits), lane_bits);
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm_blendv_epi8(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) {
+        if constexpr(std::is_signed<T>::value) return _mm_min_epi32(lhs, rhs);
+        else return _mm_min_epu32(lhs, rhs);
+    }
+    static vector higher(vector lhs, vector rhs) {
+        if constexpr(std::is_signed<T>::value) return _mm_max_epi32(lhs, rhs);
+        else return _mm_max_epu32(lhs, rhs);
+    }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs)));
+    }
+    static void store(T* out, vector keys) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), keys);
+    }
+};
+
+/**
+ *  @brief  SSE4.1 operations for floats, four lanes at a time
+ */
+template<>
+struct root_scan_lanes<float> {
+    using vector = __m128;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 4;
+    static vector load(const float* keys) { return _mm_load_ps(keys); }
+    static vector fill(float key) { return _mm_set1_ps(key); }
+    static vector select(unsigned bits) {
+        const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+        __m128i picked = _mm_and_si128(_mm_set1_epi32(int32_t(bits)), lane_bits);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(picked, lane_bits));
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm_blendv_ps(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) { return _mm_min_ps(lhs, rhs); }
+    static vector higher(vector lhs, vector rhs) { return _mm_max_ps(lhs, rhs); }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs));
+    }
+    static void store(float* out, vector keys) { _mm_storeu_ps(out, keys); }
+};
+
+/**
+ *  @brief  SSE4.1 operations for doubles, two lanes at a time
+ */
+template<>
+struct root_scan_lanes<double> {
+    using vector = __m128d;
+    static constexpr bool vectorized = true;
+    static constexpr unsigned lanes = 2;
+    static vector load(const double* keys) { return _mm_load_pd(keys); }
+    static vector fill(double key) { return _mm_set1_pd(key); }
+    static vector select(unsigned bits) {
+        const __m128i lane_bits = _mm_set_epi64x(2, 1);
+        __m128i picked = _mm_and_si128(_mm_set1_epi64x(bits), lane_bits);
+        return _mm_castsi128_pd(_mm_cmpeq_epi64(picked, lane_bits));
+    }
+    static vector blend(vector absent, vector keys, vector present) {
+        return _mm_blendv_pd(absent, keys, present);
+    }
+    static vector lower(vector lhs, vector rhs) { return _mm_min_pd(lhs, rhs); }
+    static vector higher(vector lhs, vector rhs) { return _mm_max_pd(lhs, rhs); }
+    static unsigned equal(vector lhs, vector rhs) {
+        return _mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs));
+    }
+    static void store(double* out, vector keys) { _mm_storeu_pd(out, keys); }
+};
+#endif
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                          root_key_mirror                                         *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief  The root keys of a heap, copied into one aligned array indexed by degree. The primary
+ *          template is used for keys the scan does not understand; it stores nothing.
+ *  @tparam T the type of the keys
+ *  @tparam Comp the comparison function of the heap
+ */
+template<typename T, typename Comp, bool = root_scan_order<T, Comp>::enabled>
+class root_key_mirror {
+public:
+    static constexpr bool enabled = false;
+    void store(unsigned, const T&) {}
+};
+
+/**
+ *  @brief  The root keys of a heap of arithmetic keys ordered by std::less or std::greater
+ *  @tparam T the type of the keys
+ *  @tparam Comp std::less or std::greater
+ */
+template<typename T, typename Comp>
+class root_key_mirror<T, Comp, true> {
+public:
+    static constexpr bool enabled = true;
+    root_key_mirror();
+    void store(unsigned degree, const T& key);
+    unsigned best(uint64_t occupied) const;
+private:
+    static constexpr size_t max_degree = 64;
+    static constexpr bool descending = root_scan_order<T, Comp>::descending;
+    static T absent();
+    static bool before(const T& lhs, const T& rhs);
+    unsigned scalar_best(uint64_t occupied) const;
+    template<class Lanes> unsigned vector_best(uint64_t occupied) const;
+    alignas(32) T keys[max_degree];
+};
+
+/**
+ *  @brief  Constructor for root key mirrors. Every degree starts out holding absent().
+ */
+template<typename T, typename Comp>
+root_key_mirror<T, Comp, true>::root_key_mirror() {
+    for(T& key: keys) key = absent();
+}
+
+/**
+ *  @brief      Records the key of the root of a degree
+ *  @param[in]  degree the degree of the root
+ *  @param[in]  key the key of the root
+ */
+template<typename T, typename Comp>
+void root_key_mirror<T, Comp, true>::store(unsigned degree, const T& key) { keys[degree] = key; }
+
+/**
+ *  @brief      Finds the root whose key comes first, picking the lowest degree on ties just as a
+ *              scalar scan in degree order would. Dispatched at compile time on T.
+ *  @param[in]  occupied a nonzero bitmask of the degrees that hold a root
+ *  @return     the degree of the root with the minimum key
+ */
+template<typename T, typename Comp>
+unsigned root_key_mirror<T, Comp, true>::best(uint64_t occupied) const {
+    if constexpr(root_scan_lanes<T>::vectorized) return vector_best<root_scan_lanes<T>>(occupied);
+    else return scalar_best(occupied);
+}
+
+/**
+ *  @brief  A key that no occupied root can come after, used to fill empty degrees
+ *  @return the largest key for std::less, or the smallest key for std::greater
+ */
+template<typename T, typename Comp>
+T root_key_mirror<T, Comp, true>::absent() {
+    using limits = std::numeric_limits<T>;
+    if constexpr(limits::has_infinity) return descending ? -limits::infinity() : limits::infinity();
+    else return descending ? limits::lowest() : limits::max();
+}
+
+/**
+ *  @brief      Orders two keys the way the heap's comparator does
+ *  @param[in]  lhs the left-hand key
+ *  @param[in]  rhs the right-hand key
+ *  @return     true if lhs comes strictly before rhs. Otherwise, false
+ */
+template<typename T, typename Comp>
+bool root_key_mirror<T, Comp, true>::before(const T& lhs, const T& rhs) {
+    return descending ? rhs < lhs : lhs < rhs;
+}
+
+/**
+ *  @brief      Scalar fallback: a linear scan over the mirrored keys. Still avoids touching any
+ *              node.
+ *  @param[in]  occupied a nonzero bitmask of the degrees that hold a root
+ *  @return     the degree of the root with the minimum key
+ */
+template<typename T, typename Comp>
+unsigned root_key_mirror<T, Comp, true>::scalar_best(uint64_t occupied) const {
+    unsigned found = lowest_set_bit(occupied);
+    for(uint64_t mask = occupied & (occupied - 1); mask; mask &= mask - 1) {
+        unsigned degree = lowest_set_bit(mask);
+        if(before(keys[degree], keys[found])) found = degree;
+    }
+    return found;
+}
+
+/**
+ *  @brief      Vector kernel: takes the lane-wise minimum over the occupied degrees with empty
+ *              degrees masked to absent(), reduces it horizontally, and then finds the lowest
+ *              occupied degree holding that key.
+ *  @tparam     Lanes the vector operations for T
+ *  @param[in]  occupied a nonzero bitmask of the degrees that hold a root
+ *  @return     the degree of the root with the minimum key
+ */
+template<typename T, typename Comp>
+template<class Lanes>
+unsigned root_key_mirror<T, Comp, true>::vector_best(uint64_t occupied) const {
+    constexpr unsigned lanes = Lanes::lanes;
+    constexpr uint64_t lane_mask = (uint64_t(1) << lanes) - 1;
+    const typename Lanes::vector filler = Lanes::fill(absent());
+    typename Lanes::vector extreme = filler;
+    for(unsigned base = 0; base < max_degree; base += lanes) {
+        unsigned bits = unsigned((occupied >> base) & lane_mask);
+        if(!bits) continue;
+        typename Lanes::vector present =
+            Lanes::blend(filler, Lanes::load(keys + base), Lanes::select(bits));
+        extreme = descending ? Lanes::higher(extreme, present) : Lanes::lower(extreme, present);
+    }
+    T reduced[lanes];
+    Lanes::store(reduced, extreme);
+    T found = reduced[0];
+    for(unsigned lane = 1; lane < lanes; ++lane)
+        if(before(reduced[lane], found)) found = reduced[lane];
+    const typename Lanes::vector target = Lanes::fill(found);
+    for(unsigned base = 0; base < max_degree; base += lanes) {
+        unsigned bits = unsigned((occupied >> base) & lane_mask);
+        unsigned hits = bits ? Lanes::equal(Lanes::load(keys + base), target) & bits : 0;
+        if(hits) return base + lowest_set_bit(hits);
+    }
+    return scalar_best(occupied);
+}
+#endif
@@ -0,0 +1,402 @@
+/**
+ *  @file   static_heap.h
+ *  @brief  A fixed-capacity binomial heap whose nodes live inline in the heap object. It never
+ *          allocates and can be built and used in constant expressions.
+ *
+ *  @author agent
+ *  @date   October 16, 2026
+*/
+#ifndef STATIC_BINOMIAL_HEAP
+#define STATIC_BINOMIAL_HEAP 1
+#include <array>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ *  @brief      Number of times n can be halved before reaching 1
+ *  @param[in]  n a positive number
+ *  @return     the floor of the base-2 logarithm of n
+ */
+constexpr size_t binomial_floor_log2(size_t n) {
+    size_t log = 0;
+    while(n >>= 1) ++log;
+    return log;
+}
+
+/**
+ *  @brief  A binomial heap holding at most N keys in an inline std::array. Nodes are linked by
+ *          index instead of by pointer, so copies are plain member-wise copies, and every
+ *          operation is constexpr. The linking code mirrors binomial_heap's but cannot share it,
+ *          since that code works on pointers, handle slots and a root key mirror, none of which
+ *          can be used in a constant expression.
+ *  @tparam T the type of the keys. Must be default constructible; unused nodes hold T()
+ *  @tparam N the capacity of the heap
+ *  @tparam Comp the comparison function that will be used for heap-ordering. defaults to std::less
+ */
+template<typename T, size_t N, typename Comp = std::less<T>>
+class static_binomial_heap {
+    static_assert(N > 0, "a static_binomial_heap needs room for at least one key");
+public:
+    using slot_type = size_t;
+    constexpr explicit static_binomial_heap(const Comp& compare = Comp());
+    static constexpr size_t capacity();
+    constexpr size_t size() const;
+    constexpr bool empty() const;
+    constexpr bool full() const;
+    constexpr const T& top() const;
+    constexpr const T& key(slot_type slot) const;
+    constexpr T pop();
+    constexpr slot_type insert(const T& key);
+    constexpr slot_type insert(T&& key);
+    constexpr void decrease_key(slot_type slot, T new_key);
+    constexpr void remove(slot_type slot);
+private:
+    static constexpr size_t max_degree = binomial_floor_log2(N) + 1;
+    using index_type = typename std::conditional<N < UINT8_MAX, uint8_t,
+        typename std::conditional<N < UINT16_MAX, uint16_t, uint32_t>::type
+    >::type;
+    static constexpr index_type none = index_type(N);
+    struct node {
+        constexpr node();
+        T key;
+        index_type child;
+        index_type sibling;
+        index_type back;
+        unsigned char degree;
+    };
+    constexpr index_type acquire();
+    constexpr void release(index_type target);
+    constexpr index_type promote(index_type root, index_type to_merge);
+    constexpr index_type parent(index_type target) const;
+    constexpr void add_tree(index_type tree);
+    constexpr void set_min();
+    constexpr void remove_root(index_type root);
+    constexpr void swap_with_parent(index_type target, index_type parent);
+    Comp compare;
+    std::array<node, N> nodes;
+    std::array<index_type, max_degree> trees;
+    uint64_t occupied;
+    index_type _min;
+    index_type free_head;
+    size_t bump;
+    size_t _size;
+};
+
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                               static_binomial_heap::node implementation                          *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief  Default constructor for nodes. The result is detached and holds T().
+ */
+template<typename T, size_t N, typename Comp>
+constexpr static_binomial_heap<T, N, Comp>::node::node() :
+    key(),
+    child(none),
+    sibling(none),
+    back(none),
+    degree(0) {}
+
+/***************************************************************************************************
+*                                                                                                  *
+*                                                                                                  *
+*                                static_binomial_heap implementation                               *
+*                                                                                                  *
+*                                                                                                  *
+***************************************************************************************************/
+/**
+ *  @brief      Default constructor for the static_binomial_heap class
+ *  @param[in]  compare the comparison functor for heap-ordering, defaults to std::less<T>
+ */
+template<typename T, size_t N, typename Comp>
+constexpr static_binomial_heap<T, N, Comp>::static_binomial_heap(const Comp& compare) :
+    compare(compare),
+    nodes(),
+    trees(),
+    occupied(0),
+    _min(none),
+    free_head(none),
+    bump(0),
+    _size(0) {}
+
+/**
+ *  @brief  Gets the capacity of the heap
+ *  @return N
+ */
+template<typename T, size_t N, typename Comp>
+constexpr size_t static_binomial_heap<T, N, Comp>::capacity() { return N; }
+
+/**
+ *  @brief  Gets the size of the heap
+ *  @return the size of the heap
+ */
+template<typename T, size_t N, typename Comp>
+constexpr size_t static_binomial_heap<T, N, Comp>::size() const { return _size; }
+
+/**
+ *  @brief  Returns whether or not the heap is empty
+ *  @return true if the heap has zero elements. Otherwise, false
+ */
+template<typename T, size_t N, typename Comp>
+constexpr bool static_binomial_heap<T, N, Comp>::empty() const { return !_size; }
+
+/**
+ *  @brief  Returns whether or not the heap is at capacity
+ *  @return true if the next insert would throw. Otherwise, false
+ */
+template<typename T, size_t N, typename Comp>
+constexpr bool static_binomial_heap<T, N, Comp>::full() const { return _size == N; }
+
+/**
+ *  @brief  Gets the minimum key in the heap. O(1) time.
+ *  @return the minimum key, by reference
+ */
+template<typename T, size_t N, typename Comp>
+constexpr const T& static_binomial_heap<T, N, Comp>::top() const {
+    if(_min == none) throw std::out_of_range("Empty");
+    return nodes[_min].key;
+}
+
+/**
+ *  @brief      Gets the key stored in a slot
+ *  @param[in]  slot a slot returned by insert() whose key has not been removed
+ *  @return     the key in slot, by reference
+ */
+template<typename T, size_t N, typename Comp>
+constexpr const T& static_binomial_heap<T, N, Comp>::key(slot_type slot) const {
+    return nodes[slot].key;
+}
+
+/**
+ *  @brief  Removes the minimum key from the heap. O(log N) time.
+ *  @return the removed key
+ */
+template<typename T, size_t N, typename Comp>
+constexpr T static_binomial_heap<T, N, Comp>::pop() {
+    if(_min == none) throw std::out_of_range("Empty");
+    T min_val = std::move(nodes[_min].key);
+    remove_root(_min);
+    return min_val;
+}
+
+/**
+ *  @brief      Inserts a key into the heap. O(1) am. time.
+ *  @param[in]  key the key to be inserted into the heap
+ *  @return     the slot holding key, which stays valid until key is removed
+ */
+template<typename T, size_t N, typename Comp>
+constexpr typename static_binomial_heap<T, N, Comp>::slot_type
+static_binomial_heap<T, N, Comp>::insert(const T& key) { return insert(T(key)); }
+
+/**
+ *  @brief      Inserts a key into the heap by moving it in. O(1) am. time.
+ *  @param[in]  key the key to be inserted into the heap
+ *  @return     the slot holding key, which stays valid until key is removed
+ */
+template<typename T, size_t N, typename Comp>
+constexpr typename static_binomial_heap<T, N, Comp>::slot_type
+static_binomial_heap<T, N, Comp>::insert(T&& key) {
+    index_type added = acquire();
+    nodes[added].key = std::move(key);
+    ++_size;
+    if(_min == none || compare(nodes[added].key, nodes[_min].key)) _min = added;
+    add_tree(added);
+    return added;
+}
+
+/**
+ *  @brief      Decreases the key in a slot by moving its node towards the root. O(log N) time.
+ *  @param[in]  slot a slot returned by insert() whose key has not been removed
+ *  @param[in]  new_key the value the key is to be decreased to. Must not compare greater than
+ *              the current key.
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::decrease_key(slot_type slot, T new_key) {
+    index_type target = index_type(slot);
+    if(compare(nodes[target].key, new_key)) throw std::invalid_argument("Invalid new key.");
+    nodes[target].key = std::move(new_key);
+    for(index_type above = parent(target); above != none; above = parent(target)) {
+        if(!compare(nodes[target].key, nodes[above].key)) return;
+        if(above == _min) _min = target;
+        swap_with_parent(target, above);
+    }
+    if(compare(nodes[target].key, nodes[_min].key)) _min = target;
+}
+
+/**
+ *  @brief      Removes the key in a slot by swapping its node up to the root of its tree and
+ *              removing that root. Never compares against the removed key. O(log N) time.
+ *  @param[in]  slot a slot returned by insert() whose key has not been removed
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::remove(slot_type slot) {
+    index_type target = index_type(slot);
+    for(index_type above = parent(target); above != none; above = parent(target))
+        swap_with_parent(target, above);
+    remove_root(target);
+}
+
+/**
+ *  @brief  Takes a node off the free list, or the next never-used node. O(1) time.
+ *  @return the index of a detached node
+ */
+template<typename T, size_t N, typename Comp>
+constexpr typename static_binomial_heap<T, N, Comp>::index_type
+static_binomial_heap<T, N, Comp>::acquire() {
+    if(free_head != none) {
+        index_type reused = free_head;
+        free_head = nodes[reused].sibling;
+        nodes[reused].sibling = none;
+        return reused;
+    }
+    if(bump == N) throw std::length_error("Heap is full");
+    return index_type(bump++);
+}
+
+/**
+ *  @brief      Resets a node and pushes it onto the free list
+ *  @param[in]  target the node to be freed
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::release(index_type target) {
+    nodes[target] = node();
+    nodes[target].sibling = free_head;
+    free_head = target;
+}
+
+/**
+ *  @brief      Merges two trees of the same degree, keeping root on top on ties
+ *  @param[in]  root the root of the first tree
+ *  @param[in]  to_merge the root of the second tree
+ *  @return     the root of the merged tree
+ */
+template<typename T, size_t N, typename Comp>
+constexpr typename static_binomial_heap<T, N, Comp>::index_type
+static_binomial_heap<T, N, Comp>::promote(index_type root, index_type to_merge) {
+    if(compare(nodes[to_merge].key, nodes[root].key)) {
+        index_type swapped = root;
+        root = to_merge;
+        to_merge = swapped;
+    }
+    node& top = nodes[root];
+    nodes[to_merge].sibling = top.child;
+    if(top.child != none) nodes[top.child].back = to_merge;
+    nodes[to_merge].back = root;
+    top.child = to_merge;
+    ++top.degree;
+    return root;
+}
+
+/**
+ *  @brief      Finds the parent of a node, walking back along its older siblings as
+ *              binomial_heap does
+ *  @param[in]  target the node whose parent is to be found
+ *  @return     the parent of target, or none if target is a root
+ */
+template<typename T, size_t N, typename Comp>
+constexpr typename static_binomial_heap<T, N, Comp>::index_type
+static_binomial_heap<T, N, Comp>::parent(index_type target) const {
+    while(nodes[target].back != none && nodes[nodes[target].back].child != target)
+        target = nodes[target].back;
+    return nodes[target].back;
+}
+
+/**
+ *  @brief      Adds a tree to the root array like a carry in a binary counter. The current min
+ *              is always kept as a root.
+ *  @param[in]  tree the root of the tree to be added
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::add_tree(index_type tree) {
+    size_t degree = nodes[tree].degree;
+    for(; occupied & (uint64_t(1) << degree); ++degree) {
+        occupied &= ~(uint64_t(1) << degree);
+        index_type root = trees[degree];
+        tree = tree == _min ? promote(tree, root) : promote(root, tree);
+    }
+    trees[degree] = tree;
+    occupied |= uint64_t(1) << degree;
+}
+
+/**
+ *  @brief  Finds the min value of all of the roots. O(log N) time.
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::set_min() {
+    _min = none;
+    for(size_t degree = 0; degree < max_degree; ++degree) {
+        if(!(occupied & (uint64_t(1) << degree))) continue;
+        index_type tree = trees[degree];
+        if(_min == none || compare(nodes[tree].key, nodes[_min].key)) _min = tree;
+    }
+}
+
+/**
+ *  @brief      Removes a root from the heap, adding each of its subtrees back to the root array
+ *              and freeing its node. O(log N) time.
+ *  @param[in]  root the root to be removed
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::remove_root(index_type root) {
+    occupied &= ~(uint64_t(1) << nodes[root].degree);
+    _min = none;
+    for(index_type child = nodes[root].child; child != none;) {
+        index_type next = nodes[child].sibling;
+        nodes[child].sibling = none;
+        nodes[child].back = none;
+        add_tree(child);
+        child = next;
+    }
+    release(root);
+    set_min();
+    --_size;
+}
+
+/**
+ *  @brief      Exchanges the positions of a node and its parent in constant time, exactly as
+ *              binomial_heap does. Keys never move, so slots stay attached to their keys.
+ *  @param[in]  target the node to be moved up one level
+ *  @param[in]  parent the current parent of target
+ */
+template<typename T, size_t N, typename Comp>
+constexpr void static_binomial_heap<T, N, Comp>::swap_with_parent(
+    index_type target,
+    index_type parent
+) {
+    node& moved = nodes[target];
+    node& above = nodes[parent];
+    index_type parent_back = above.back;
+    index_type parent_sibling = above.sibling;
+    index_type target_children = moved.child;
+    if(above.child == target) {
+        moved.child = parent;
+        above.back = target;
+    } else {
+        moved.child = above.child;
+        nodes[moved.child].back = target;
+        nodes[moved.back].sibling = parent;
+        above.back = moved.back;
+    }
+    above.sibling = moved.sibling;
+    if(above.sibling != none) nodes[above.sibling].back = parent;
+    above.child = target_children;
+    if(target_children != none) nodes[target_children].back = parent;
+    moved.back = parent_back;
+    moved.sibling = parent_sibling;
+    if(parent_sibling != none) nodes[parent_sibling].back = target;
+    if(parent_back == none) trees[above.degree] = target;
+    else if(nodes[parent_back].child == parent) nodes[parent_back].child = target;
+    else nodes[parent_back].sibling = target;
+    unsigned char degree = moved.degree;
+    moved.degree = above.degree;
+    above.degree = degree;
+}
+#endif